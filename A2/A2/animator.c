@@ -6,6 +6,7 @@
  */ 
 
 #include <stdint.h>
+#include <avr/pgmspace.h>
 #include "animator.h"
 #include "pixel_colour.h"
 #include "ledmatrix.h"
@@ -15,7 +16,7 @@
 
 // Game over scroll text
 // Each element represents column of size 8 in LED matrix display.
-static uint8_t game_over_vert_text[62] = {
+static const uint8_t game_over_vert_text[62] PROGMEM = {
 	0, 0, 0x40, 0x7c, 0x40, 0x4c, 0x44, 0x78, 0,	//G
 	0x38, 0x44, 0x44, 0x7c, 0x44, 0x44, 0,			//A
 	0x44, 0x6c, 0x54, 0x44, 0x44, 0x44, 0,			//M
@@ -28,23 +29,28 @@ static uint8_t game_over_vert_text[62] = {
 };
 
 
-uint8_t scroll_playing_flag = 0;
-uint8_t anim_paused_flag = 0;
+// Set from the main loop and read by the timer interrupt
+volatile uint8_t scroll_playing_flag = 0;
+volatile uint8_t anim_paused_flag = 0;
 
 // Scroll animation global variables (only accessed locally)
 PixelColour current_scroll_colour;
 uint8_t current_scroll_head_index;
-static uint8_t * current_scroll_anim;
+static const uint8_t* current_scroll_anim;	// In program memory
 uint8_t current_scroll_length;
 uint8_t current_scroll_direction;
 uint16_t current_scroll_frame_time;
 uint32_t current_scroll_time;
 
-// Move animation global variable (only accessed locally)
+// Move animation global variables (only accessed locally)
 uint32_t current_move_time;
+// Set by the main loop to have the interrupt take the first move step now
+volatile uint8_t move_anim_start;
 
 // Set the global variables for the current scroll animation
-void set_scroll_anim(uint8_t* pixel_columns, uint8_t pixel_columns_length, PixelColour pixel_colours, uint16_t frame_time, uint8_t scroll_direction) {
+void set_scroll_anim(const uint8_t* pixel_columns, uint8_t pixel_columns_length, PixelColour pixel_colours, uint16_t frame_time, uint8_t scroll_direction) {
+	// Stop the interrupt using the animation while it is changed
+	scroll_playing_flag = 0;
 	current_scroll_anim = pixel_columns;
 	current_scroll_length = pixel_columns_length;
 	current_scroll_colour = pixel_colours;
@@ -77,7 +83,7 @@ void scroll_anim(void) {
 	// of the animation then the entire image is not yet displayed 
 	if (current_scroll_length > current_scroll_head_index) {
 		// Get the current column of pixel data from the scroll animation
-		anim_column_data = current_scroll_anim[current_scroll_head_index];
+		anim_column_data = pgm_read_byte(&current_scroll_anim[current_scroll_head_index]);
 		
 		// Iterate over the pixel array to set on/off
 		for (int8_t column_index = 8; column_index > 0; column_index--) {
@@ -103,10 +109,10 @@ void scroll_anim(void) {
 
 }
 
-// Initialise move animation
+// Initialise move animation. The steps are always taken by the timer
+// interrupt, which is the only consumer of the move queues.
 void set_move_anim(void) {
-	current_move_time = get_current_time();
-	move_anim();
+	move_anim_start = 1;
 }
 
 // Continuously play animations if any are being played
@@ -121,9 +127,10 @@ void play_animations(void) {
 			}
 		}
 		
-		if (current_time >= current_move_time + MOVE_SPEED) {
+		if (move_anim_start || current_time >= current_move_time + MOVE_SPEED) {
 			move_anim();
 			current_move_time = current_time;
+			move_anim_start = 0;
 		}	
 	}
 }
@@ -138,7 +145,8 @@ void stop_animations(void) {
 	scroll_playing_flag = 0;
 }
 
-// Play game over scroll animation
+// Play game over scroll animation, over the top of the board
 void play_game_over_anim(void) {
+	display_show_overlay(1);
 	set_scroll_anim(game_over_vert_text, 62, COLOUR_GREEN, 80, SCROLL_UP);
 }
\ No newline at end of file
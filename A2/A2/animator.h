@@ -19,7 +19,8 @@
 #include "ledmatrix.h"
 #include "pixel_colour.h"
 
-void set_scroll_anim(uint8_t* pixel_columns, uint8_t pixel_columns_length,  PixelColour pixel_colours, uint16_t frame_time, uint8_t scroll_direction);
+// Scroll pixel_columns (in program memory) across the LED matrix
+void set_scroll_anim(const uint8_t* pixel_columns, uint8_t pixel_columns_length,  PixelColour pixel_colours, uint16_t frame_time, uint8_t scroll_direction);
 
 void scroll_anim(void);
 
@@ -8,6 +8,7 @@
 #include <stdint.h>
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <avr/pgmspace.h>
 #include "buzzer.h"
 #include "timer0.h"
 
@@ -23,7 +24,7 @@ uint8_t tone_mute_flag;
 uint8_t game_mute_flag = 0;
 uint8_t melody_playing_flag;
 
-sound *melody_sounds;
+const sound *melody_sounds;
 uint8_t melody_sound_index;
 uint8_t melody_length;
 
@@ -32,6 +33,10 @@ uint32_t tone_start_time;
 uint16_t tone_duration;
 
 void init_buzzer(void) {	
+#ifdef LEDMATRIX_USART1
+	// OC1B's pin is the LED matrix clock (XCK1), so the buzzer is silent
+	TCCR1A = (1 << WGM11) | (1 << WGM10);
+#else
 	// Make pin OC1B be an output
 	DDRD |= (1 << DDRD4);
 	
@@ -40,6 +45,7 @@ void init_buzzer(void) {
 	// Output OC1B clears on compare match and set on timer/counter
 	// overflow (non-inverting mode).
 	TCCR1A = (1 << COM1A1) | (1 << COM1A0) | (1 << COM1B1) | (1 << COM1B0) | (1 << WGM11) | (1 << WGM10);
+#endif
 	TCCR1B = (1 << WGM13) | (1 << WGM12) | (1 << CS10);	
 	
 	// Initialise buzzer flags
@@ -90,11 +96,12 @@ void play_buzzer(void) {
 	}
 	else if (melody_playing_flag && !tone_mute_flag) {
 		// Play melody (array of sounds) if melody has not finished
-		if (melody_sound_index < melody_length)	{
+		if (melody_sound_index + 1 < melody_length)	{
 			melody_sound_index++;
 			
-			// Grab sound from melody pointer array
-			sound next_sound = *(melody_sounds + melody_sound_index);
+			// Grab sound from melody pointer array (in program memory)
+			sound next_sound;
+			memcpy_P(&next_sound, melody_sounds + melody_sound_index, sizeof(sound));
 			play_sound(next_sound);
 		}
 		else melody_playing_flag = 0;
@@ -121,14 +128,17 @@ void play_sound(sound buzzer_sound) {
 	set_tone(buzzer_sound.frequency, buzzer_sound.dutycycle, buzzer_sound.slide, buzzer_sound.duration);
 }
 
-// Play given melody of sounds
-void play_melody(sound *buzzer_melody, uint8_t buzzer_melody_length) {
+// Play given melody of sounds (an array in program memory)
+void play_melody(const sound *buzzer_melody, uint8_t buzzer_melody_length) {
+	sound first_sound;
+	
 	melody_sounds = buzzer_melody;
 	melody_sound_index = 0;
 	melody_length = buzzer_melody_length;
 	melody_playing_flag = 1;
 	
-	play_sound(*(melody_sounds + melody_sound_index));
+	memcpy_P(&first_sound, melody_sounds, sizeof(sound));
+	play_sound(first_sound);
 }
 
 // Store the parts of a given sound locally and add to play queue
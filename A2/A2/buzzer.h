@@ -10,6 +10,7 @@
 #define BUZZER_H_
 
 #include <stdint.h>
+#include <avr/pgmspace.h>
 #include "notes.h"
 
 #define UNUSED_VAR     __attribute__ ((unused))
@@ -25,19 +26,20 @@ static const sound button_sound = {700, 50.0, 5, 50};
 static const sound move_sound = {580, 25.0, 5, 80};
 static const sound snake_sound = {780, 50.0, -5, 500};
 
-UNUSED_VAR static sound ladder_sound[3] = {
+// Melodies are kept in program memory, they would take over 600 bytes of RAM.
+UNUSED_VAR static const sound ladder_sound[3] PROGMEM = {
 	{380, 30.0, 5, 400},
 	REST(100),
 	{650, 45.0, -20, 50}
 };
 
-UNUSED_VAR static sound gameover_sound[17] = {
+UNUSED_VAR static const sound gameover_sound[17] PROGMEM = {
 	  NOTE_E5(HALF), NOTE_C5(HALF), NOTE_D5(HALF), NOTE_B4(HALF), NOTE_C5(HALF), NOTE_A4(HALF),
 	  NOTE_GS4(HALF), NOTE_B4(QUARTER), REST(QUARTER), NOTE_E5(HALF), NOTE_C5(HALF), NOTE_D5(HALF),
 	  NOTE_B4(HALF), NOTE_C5(QUARTER), NOTE_E5(QUARTER), NOTE_A5(HALF), NOTE_GS5(HALF)
 };
 
-UNUSED_VAR static sound start_sound[38] = {
+UNUSED_VAR static const sound start_sound[38] PROGMEM = {
 	NOTE_E5(QUARTER), NOTE_B4(EIGHTH), NOTE_C5(EIGHTH),	NOTE_D5(QUARTER), NOTE_C5(EIGHTH), NOTE_B4(EIGHTH),
 	NOTE_A4(QUARTER), NOTE_A4(EIGHTH), NOTE_C5(EIGHTH),	NOTE_E5(QUARTER), NOTE_D5(EIGHTH), NOTE_C5(EIGHTH),
 	NOTE_B4(DOTQUARTER), NOTE_C5(EIGHTH), NOTE_D5(QUARTER),	NOTE_E5(QUARTER), NOTE_C5(QUARTER), NOTE_A4(QUARTER),
@@ -61,7 +63,7 @@ void play_buzzer(void);
 
 void play_sound(sound buzzer_sound);
 
-void play_melody(sound *buzzer_melody, uint8_t buzzer_melody_length);
+void play_melody(const sound *buzzer_melody, uint8_t buzzer_melody_length);
 
 void set_tone(uint16_t buzzer_frequency, float buzzer_dutycycle, int8_t buzzer_slide, uint16_t buzzer_duration);
 
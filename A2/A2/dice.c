@@ -78,3 +78,24 @@ uint8_t dice_roll(void) {
 uint8_t dice_roll_rand(void) {
 	return p_rand_next(6) + 1;
 }
+
+// Return the dice state packed in one byte: the displayed number in bits 0-2
+// and the rolling flag in bit 7.
+uint8_t get_dice_state(void) {
+	return (player_dice_roll_num & 0x07) | (player_dice_roll << 7);
+}
+
+// Restore a dice state returned by get_dice_state().
+void set_dice_state(uint8_t dice_state) {
+	player_dice_roll_num = dice_state & 0x07;
+	player_dice_roll = dice_state >> 7;
+	player_dice_roll_finish = 0;
+	
+	// Match the dice indicator LED on Port D3 to the rolling state.
+	if (player_dice_roll) {
+		PORTD |= (1 << PORTD3);
+	}
+	else {
+		PORTD &= ~(1 << PORTD3);
+	}
+}
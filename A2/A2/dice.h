@@ -27,4 +27,11 @@ uint8_t dice_roll_rand(void);
 uint8_t get_dice_rolling(void);
 
 uint8_t get_dice_roll_finish(void);
+
+// Return the dice state packed in one byte: the displayed number in bits 0-2
+// and the rolling flag in bit 7.
+uint8_t get_dice_state(void);
+
+// Restore a dice state returned by get_dice_state().
+void set_dice_state(uint8_t dice_state);
 #endif
\ No newline at end of file
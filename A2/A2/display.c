@@ -7,17 +7,55 @@
 #include "display.h"
 #include <stdio.h>
 #include <avr/pgmspace.h>
+#include <util/atomic.h>
 #include "pixel_colour.h"
 #include "ledmatrix.h"
 #include "game.h"
 
 // constant value used to display 'SNKLD' on launch
-static const uint8_t snkld_display[MATRIX_NUM_COLUMNS] = 
+static const uint8_t snkld_display[MATRIX_NUM_COLUMNS] PROGMEM = 
 		{117, 85, 93, 124, 64, 124, 125, 17, 109, 0, 124, 4, 4, 125, 69, 57};
 
+// Boards taller than the matrix are shown through a viewport of
+// MATRIX_NUM_COLUMNS rows starting at board row view_row. Squares outside it
+// are not drawn, and the rows scrolled in are drawn from the game.
+#if HEIGHT > MATRIX_NUM_COLUMNS
+static volatile uint8_t view_row;
+#else
+#define view_row 0
+#endif
+
+// Rows kept in view ahead of and behind the row being followed
+#define VIEW_MARGIN 3
+
+// The matrix is composed from layers, from the top: the effects, the player
+// tokens (player 1 on top) and the board, read from the game. While an
+// overlay (the start screen or the game over text) is shown it has the whole
+// matrix to itself, and the layers are drawn again when it is taken down.
+// Whenever a layer changes only the squares it changed are worked out again
+// from all the layers, so nothing needs to remember what a token or effect
+// was covering. Tokens are moved by the timer interrupt, so the layers are
+// changed and squares drawn with interrupts off.
+static int8_t token_x[MAX_PLAYERS];
+static int8_t token_y[MAX_PLAYERS];
+static uint8_t tokens_shown;	// bit PLAYER_INDEX() of each token shown
+static int8_t effect_x[DISPLAY_EFFECTS];
+static int8_t effect_y[DISPLAY_EFFECTS];
+static uint8_t effect_object[DISPLAY_EFFECTS];
+static uint8_t effects_shown;	// bit of each effect shown
+static uint8_t overlay_shown;
+
 void initialise_display(void) {
-	// start by clearing the LED matrix
+	// start by clearing the LED matrix and taking everything off the board
 	ledmatrix_clear();
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		tokens_shown = 0;
+		effects_shown = 0;
+		overlay_shown = 0;
+#if HEIGHT > MATRIX_NUM_COLUMNS
+		view_row = 0;
+#endif
+	}
 
 	// create an array with the background colour at every position
 	PixelColour col_colours[MATRIX_NUM_ROWS];
@@ -57,9 +95,10 @@ void start_display(void) {
 	MatrixColumn column_colour_data;
 	uint8_t col_data;
 		
+	display_show_overlay(1);
 	ledmatrix_clear(); // start by clearing the LED matrix
 	for (uint8_t col = 0; col < MATRIX_NUM_COLUMNS; col++) {
-		col_data = snkld_display[col];
+		col_data = pgm_read_byte(&snkld_display[col]);
 		// using the LSB as the colour determining bit, 1 is red, 0 is green
 		if (col_data & 0x01) {
 			colour = COLOUR_RED;
@@ -82,10 +121,8 @@ void start_display(void) {
 	}
 }
 
-// Update the square colour to the display. The object passed can be the object
-// type or an object instance (which additionally has an ID number if 
-// applicable -see get_object_type in game.c/h)
-void update_square_colour(uint8_t x, uint8_t y, uint8_t object) {
+// Return the colour of an object type or object instance
+static PixelColour object_colour(uint8_t object) {
 	// determine which colour corresponds to this object
 	PixelColour colour;
 	object = get_object_type(object);
@@ -104,6 +141,12 @@ void update_square_colour(uint8_t x, uint8_t y, uint8_t object) {
 		case PLAYER_2:
 			colour = MATRIX_COLOUR_P2;
 			break;
+		case PLAYER_3:
+			colour = MATRIX_COLOUR_P3;
+			break;
+		case PLAYER_4:
+			colour = MATRIX_COLOUR_P4;
+			break;
 			
 		// All snakes should be the same colour
 		case SNAKE_START:	/* FALLTHROUGH */
@@ -127,7 +170,156 @@ void update_square_colour(uint8_t x, uint8_t y, uint8_t object) {
 			colour = MATRIX_COLOUR_EMPTY;
 			break;
 	}
+	return colour;
+}
+
+// Return the object shown at square (x, y), from the topmost layer there
+static uint8_t square_object(int8_t x, int8_t y) {
+	for (uint8_t i = 0; i < DISPLAY_EFFECTS; i++) {
+		if ((effects_shown & (1 << i)) && effect_x[i] == x && effect_y[i] == y) {
+			return effect_object[i];
+		}
+	}
+	for (uint8_t i = 0; i < MAX_PLAYERS; i++) {
+		if ((tokens_shown & (1 << i)) && token_x[i] == x && token_y[i] == y) {
+			return PLAYER_NUM(i);
+		}
+	}
+	return get_object_type_at(x, y);
+}
+
+// Draw square (x, y) from the layers. Squares outside the viewport are drawn
+// when they are scrolled in. Interrupts must be off.
+static void draw_square(int8_t x, int8_t y) {
+	if (overlay_shown || y < view_row || y >= view_row + MATRIX_NUM_COLUMNS) {
+		return;
+	}
+	ledmatrix_update_pixel(y - view_row, WIDTH - 1 - x, object_colour(square_object(x, y)));
+}
+
+// Draw matrix column 'column' of the viewport from the layers. Interrupts
+// must be off.
+static void draw_view_column(uint8_t column) {
+	MatrixColumn colours;
+	
+	for (uint8_t x = 0; x < WIDTH; x++) {
+		colours[WIDTH - 1 - x] = object_colour(square_object(x, view_row + column));
+	}
+	ledmatrix_update_column(column, colours);
+}
+
+void display_redraw_square(int8_t x, int8_t y) {
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		draw_square(x, y);
+	}
+}
 
-	// Update the pixel at the given location with this colour
-	ledmatrix_update_pixel(y, WIDTH - 1 - x, colour);
+void display_redraw(void) {
+	// A column at a time, to keep interrupts off only briefly
+	for (uint8_t column = 0; column < MATRIX_NUM_COLUMNS; column++) {
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+			if (!overlay_shown) {
+				draw_view_column(column);
+			}
+		}
+	}
+}
+
+void display_place_token(uint8_t player_num, int8_t x, int8_t y) {
+	uint8_t i = PLAYER_INDEX(player_num);
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		int8_t old_x = token_x[i];
+		int8_t old_y = token_y[i];
+		
+		token_x[i] = x;
+		token_y[i] = y;
+		if (tokens_shown & (1 << i)) {
+			draw_square(old_x, old_y);
+			draw_square(x, y);
+		}
+	}
+}
+
+void display_show_token(uint8_t player_num, uint8_t shown) {
+	uint8_t i = PLAYER_INDEX(player_num);
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		if (shown) {
+			tokens_shown |= (1 << i);
+		} else {
+			tokens_shown &= ~(1 << i);
+		}
+		draw_square(token_x[i], token_y[i]);
+	}
+}
+
+void display_show_effect(uint8_t effect, int8_t x, int8_t y, uint8_t object) {
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		int8_t old_x = effect_x[effect];
+		int8_t old_y = effect_y[effect];
+		uint8_t was_shown = effects_shown & (1 << effect);
+		
+		effect_x[effect] = x;
+		effect_y[effect] = y;
+		effect_object[effect] = object;
+		effects_shown |= (1 << effect);
+		if (was_shown) {
+			draw_square(old_x, old_y);
+		}
+		draw_square(x, y);
+	}
+}
+
+void display_hide_effect(uint8_t effect) {
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		if (effects_shown & (1 << effect)) {
+			effects_shown &= ~(1 << effect);
+			draw_square(effect_x[effect], effect_y[effect]);
+		}
+	}
+}
+
+void display_show_overlay(uint8_t shown) {
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		overlay_shown = shown;
+	}
+	if (!shown) {
+		display_redraw();
+	}
+}
+
+// Scroll the viewport by a row towards keeping board row y VIEW_MARGIN rows
+// from its edges. The matrix is shifted and only the row scrolled in is drawn.
+// Interrupts are held off so the timer interrupt never draws a moving token
+// between the shift and the change of view_row. Must be called from
+// the main loop. Returns 1 if the view moved. The view stays put while an
+// overlay is shown.
+uint8_t display_follow_row(uint8_t y) {
+#if HEIGHT > MATRIX_NUM_COLUMNS
+	uint8_t scrolled = 0;
+	
+	if (overlay_shown) {
+		return 0;
+	}
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		if (view_row > 0 && y < view_row + VIEW_MARGIN) {
+			ledmatrix_shift_display_right();
+			view_row--;
+			draw_view_column(0);
+			scrolled = 1;
+		}
+		else if (view_row < HEIGHT - MATRIX_NUM_COLUMNS && y + VIEW_MARGIN >= view_row + MATRIX_NUM_COLUMNS) {
+			ledmatrix_shift_display_left();
+			view_row++;
+			draw_view_column(MATRIX_NUM_COLUMNS - 1);
+			scrolled = 1;
+		}
+	}
+	return scrolled;
+#else
+	(void) y;
+	return 0;
+#endif
 }
\ No newline at end of file
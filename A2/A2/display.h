@@ -20,6 +20,8 @@
 #define MATRIX_COLOUR_START_END	COLOUR_LIGHT_YELLOW
 #define MATRIX_COLOUR_P1		COLOUR_ORANGE
 #define MATRIX_COLOUR_P2		COLOUR_YELLOW
+#define MATRIX_COLOUR_P3		COLOUR_LIGHT_ORANGE
+#define MATRIX_COLOUR_P4		COLOUR_LIGHT_GREEN
 #define MATRIX_COLOUR_SNAKE		COLOUR_RED
 #define MATRIX_COLOUR_LADDER	COLOUR_GREEN
 #define MATRIX_COLOUR_SNAKE_LADDER	COLOUR_RED_GREEN
@@ -31,9 +33,41 @@ void initialise_display(void);
 // Shows a starting display.
 void start_display(void);
 
-// Updates the colour at square (x, y) to be the colour
-// of the object 'object'.
-void update_square_colour(uint8_t x, uint8_t y, uint8_t object);
+// The display is drawn from layers: the board (as returned by
+// get_object_type_at()), one token for each player and, above them, up to
+// DISPLAY_EFFECTS effects that each show an object on a single square. The
+// functions below change a layer and draw again just the squares it changed.
+// They may be called from interrupts.
+#define DISPLAY_EFFECTS 2	// Effect 0 is drawn on top
+
+// Draws square (x, y) again after the board has changed there.
+void display_redraw_square(int8_t x, int8_t y);
+
+// Draws the whole board again, e.g. once a new level is loaded.
+void display_redraw(void);
+
+// Moves the token of player 'player_num' to square (x, y).
+void display_place_token(uint8_t player_num, int8_t x, int8_t y);
+
+// Shows (1) or hides (0) the token of player 'player_num', for blinking it.
+void display_show_token(uint8_t player_num, uint8_t shown);
+
+// Shows 'object' on square (x, y) as effect 'effect', moving it if it is
+// already shown.
+void display_show_effect(uint8_t effect, int8_t x, int8_t y, uint8_t object);
+
+// Takes effect 'effect' off the board.
+void display_hide_effect(uint8_t effect);
+
+// While an overlay is shown (1) the layers are not drawn and the caller has
+// the LED matrix to itself. Taking it down (0) draws the layers again.
+// initialise_display() takes down any overlay and hides all tokens and effects.
+void display_show_overlay(uint8_t shown);
+
+// Boards taller than the LED matrix are shown through a scrolling viewport.
+// Scrolls the viewport one row towards keeping board row y in view, returning
+// 1 if it moved. Does nothing on boards that fit the matrix.
+uint8_t display_follow_row(uint8_t y);
 
 
 #endif /* DISPLAY_H_ */
\ No newline at end of file
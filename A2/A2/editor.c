@@ -0,0 +1,292 @@
+/*
+ * editor.c
+ *
+ * Created: 17/10/2026 11:12:21 PM
+ *  Author: LiamM
+ *
+ * Board editor. Works on the game board in place, so the edited board can
+ * be saved straight into an upload slot. Snakes and ladders are placed by
+ * marking their start and then their end, and the body is drawn as a
+ * king-move line between them as with generated boards. No square may be
+ * used twice, so jumps never chain and the start and finish stay where the
+ * path puts them. Only the squares that change are redrawn. The cursor and
+ * the marked start are shown as display effects over the board.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "editor.h"
+#include "gameboard.h"
+#include "levelupload.h"
+#include "game.h"
+#include "display.h"
+
+// Display effects used, the cursor is drawn over the marked start
+#define CURSOR_EFFECT	0
+#define MARK_EFFECT		1
+
+static level_data* level;
+static int8_t cursor_x;
+static int8_t cursor_y;
+static uint8_t cursor_visible;
+
+// Type of the start marked for the snake or ladder being placed, or
+// EMPTY_SQUARE if there is none.
+static uint8_t marked_type;
+static int8_t marked_x;
+static int8_t marked_y;
+
+// Show or hide the cursor as cursor_visible says.
+static void draw_cursor(void) {
+	if (cursor_visible) {
+		display_show_effect(CURSOR_EFFECT, cursor_x, cursor_y, PLAYER_1);
+	}
+	else {
+		display_hide_effect(CURSOR_EFFECT);
+	}
+}
+
+// Step from (x,y) one king move towards (end_x,end_y).
+static void step_towards(int8_t* x, int8_t* y, int8_t end_x, int8_t end_y) {
+	*x += (end_x > *x) - (end_x < *x);
+	*y += (end_y > *y) - (end_y < *y);
+}
+
+// Return the identifier of the link using a square, or 0 if none.
+static uint8_t link_at(packed_square square) {
+	level_link link;
+	
+	for (uint8_t i = 1; level_get_link(level, i, &link); i++) {
+		if (link.start == square || link.end == square) return i;
+		for (uint8_t j = 0; j < link.body_length; j++) {
+			if (level_body_square(level, i, j) == square) return i;
+		}
+	}
+	return 0;
+}
+
+// Follow the chained jumps (only on boards from the level pack) from the end
+// of each link to its destination.
+static void update_destinations(void) {
+	level_link link;
+	
+	for (uint8_t i = 1; level_get_link(level, i, &link); i++) {
+		packed_square square = link.end;
+		
+		for (uint8_t hops = 0; hops < MAX_LEVEL_LINKS; hops++) {
+			uint8_t object = level_object_at(level, UNPACK_SQUARE_X(square), UNPACK_SQUARE_Y(square));
+			uint8_t type = get_object_type(object);
+			level_link next;
+			
+			if (type != SNAKE_START && type != LADDER_START) break;
+			level_get_link(level, get_object_identifier(object), &next);
+			square = next.end;
+		}
+		level_set_destination(level, i, square);
+	}
+}
+
+// Scroll a tall board until the cursor is in view.
+static void follow_cursor(void) {
+	while (display_follow_row(cursor_y)) {
+		// Scroll another row
+	}
+}
+
+void editor_start(void) {
+	level = get_game_board();
+	level_make_editable(level);
+	cursor_x = SQUARE_INDEX_X(0);
+	cursor_y = SQUARE_INDEX_Y(0);
+	cursor_visible = 1;
+	marked_type = EMPTY_SQUARE;
+	follow_cursor();
+	draw_cursor();
+}
+
+void editor_move_cursor(int8_t dx, int8_t dy) {
+	int8_t x = cursor_x + dx;
+	int8_t y = cursor_y + dy;
+	
+	if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT) return;
+	
+	cursor_x = x;
+	cursor_y = y;
+	cursor_visible = 1;
+	follow_cursor();
+	draw_cursor();
+}
+
+void editor_flash_cursor(void) {
+	cursor_visible = 1 - cursor_visible;
+	draw_cursor();
+}
+
+uint8_t editor_place(uint8_t ladder) {
+	uint8_t start_type = ladder ? LADDER_START : SNAKE_START;
+	
+	if (level_type_at(level, cursor_x, cursor_y) != EMPTY_SQUARE) return EDIT_TAKEN;
+	
+	// The first press marks the start.
+	if (marked_type != start_type) {
+		if (level->num_links >= MAX_LEVEL_LINKS) return EDIT_FULL;
+		
+		marked_type = start_type;
+		marked_x = cursor_x;
+		marked_y = cursor_y;
+		display_show_effect(MARK_EFFECT, marked_x, marked_y, marked_type);
+		return EDIT_MARKED;
+	}
+	
+	square_index start_index = SQUARE_INDEX(marked_x, marked_y);
+	square_index end_index = SQUARE_INDEX(cursor_x, cursor_y);
+	
+	if (ladder ? (end_index <= start_index) : (end_index >= start_index)) return EDIT_WRONG_WAY;
+	
+	// Check the whole line before drawing any of it.
+	int8_t x = marked_x;
+	int8_t y = marked_y;
+	uint8_t length = 0;
+	
+	while (x != cursor_x || y != cursor_y) {
+		step_towards(&x, &y, cursor_x, cursor_y);
+		if (level_type_at(level, x, y) != EMPTY_SQUARE) return EDIT_TAKEN;
+		length++;
+	}
+	
+	// length counts the end square, the body is the squares in between.
+	length--;
+	if (length > MAX_LEVEL_BODY || level_body_used(level) + length > LEVEL_BODY_POOL_SIZE) return EDIT_TOO_LONG;
+	
+	level_add_link(level, PACK_SQUARE(marked_x, marked_y), PACK_SQUARE(cursor_x, cursor_y));
+	level_set_cell(level, marked_x, marked_y, start_type);
+	level_set_cell(level, cursor_x, cursor_y, ladder ? LADDER_END : SNAKE_END);
+	marked_type = EMPTY_SQUARE;
+	display_hide_effect(MARK_EFFECT);
+	
+	x = marked_x;
+	y = marked_y;
+	for (uint8_t i = 0; i < length; i++) {
+		step_towards(&x, &y, cursor_x, cursor_y);
+		level_set_cell(level, x, y, ladder ? LADDER_MIDDLE : SNAKE_MIDDLE);
+		level_add_body_square(level, PACK_SQUARE(x, y));
+		display_redraw_square(x, y);
+	}
+	display_redraw_square(cursor_x, cursor_y);
+	
+	return EDIT_OK;
+}
+
+uint8_t editor_delete(void) {
+	uint8_t identifier = link_at(PACK_SQUARE(cursor_x, cursor_y));
+	level_link link;
+	
+	if (identifier == 0) {
+		if (marked_type == EMPTY_SQUARE) return EDIT_NOTHING;
+		
+		marked_type = EMPTY_SQUARE;
+		display_hide_effect(MARK_EFFECT);
+		return EDIT_OK;
+	}
+	
+	level_get_link(level, identifier, &link);
+	uint8_t ladder = (level_type_at(level, UNPACK_SQUARE_X(link.start), UNPACK_SQUARE_Y(link.start)) == LADDER_START);
+	
+	// Clear its squares. Where it crosses the other kind (on boards from the
+	// level pack) the other body is left. The body is read from the link, so
+	// this is done before the link is removed.
+	level_set_cell(level, UNPACK_SQUARE_X(link.start), UNPACK_SQUARE_Y(link.start), EMPTY_SQUARE);
+	level_set_cell(level, UNPACK_SQUARE_X(link.end), UNPACK_SQUARE_Y(link.end), EMPTY_SQUARE);
+	display_redraw_square(UNPACK_SQUARE_X(link.start), UNPACK_SQUARE_Y(link.start));
+	display_redraw_square(UNPACK_SQUARE_X(link.end), UNPACK_SQUARE_Y(link.end));
+	for (uint8_t i = 0; i < link.body_length; i++) {
+		packed_square square = level_body_square(level, identifier, i);
+		int8_t x = UNPACK_SQUARE_X(square);
+		int8_t y = UNPACK_SQUARE_Y(square);
+		uint8_t type = EMPTY_SQUARE;
+		
+		if (level_type_at(level, x, y) == SNAKE_LADDER_MIDDLE) {
+			type = ladder ? SNAKE_MIDDLE : LADDER_MIDDLE;
+		}
+		level_set_cell(level, x, y, type);
+		display_redraw_square(x, y);
+	}
+	
+	// Identifiers come from the link order, so the links after it are simply
+	// renumbered.
+	level_remove_link(level, identifier);
+	update_destinations();
+	
+	return EDIT_OK;
+}
+
+// Return where landing on path index square leads: the destination of a snake
+// or ladder starting there, else the square itself.
+static square_index jump_destination(square_index square) {
+	uint8_t object = level_object_at(level, SQUARE_INDEX_X(square), SQUARE_INDEX_Y(square));
+	uint8_t type = get_object_type(object);
+	level_link link;
+	
+	if ((type == SNAKE_START || type == LADDER_START) && level_get_link(level, get_object_identifier(object), &link)) {
+		return SQUARE_INDEX(UNPACK_SQUARE_X(link.destination), UNPACK_SQUARE_Y(link.destination));
+	}
+	return square;
+}
+
+// Return 1 if the finish can be reached from the start. Squares reached are
+// marked in a bitboard by path index, and the path is swept until no more
+// squares are reached (snakes can lead back to squares already swept).
+static uint8_t finish_reachable(void) {
+	bitboard reached;
+	square_index last = BOARD_SQUARES - 1;
+	uint8_t changed = 1;
+	
+	memset(reached, 0, sizeof(reached));
+	reached[0] = 1;
+	
+	while (changed) {
+		changed = 0;
+		for (square_index index = 0; index < last; index++) {
+			if (!(reached[index / WIDTH] & (1 << (index % WIDTH)))) continue;
+			
+			for (uint8_t dice = 1; dice <= 6; dice++) {
+				square_index target = roll_destination(index, dice, jump_destination);
+				
+				if (!(reached[target / WIDTH] & (1 << (target % WIDTH)))) {
+					reached[target / WIDTH] |= 1 << (target % WIDTH);
+					changed = 1;
+				}
+			}
+		}
+	}
+	
+	return (reached[last / WIDTH] & (1 << (last % WIDTH))) != 0;
+}
+
+uint8_t editor_save(uint8_t slot, uint8_t* board_num) {
+	uint8_t num_levels = get_num_levels();
+	
+	if (!finish_reachable()) return EDIT_UNREACHABLE;
+	
+	// An uploaded board is saved back into its own slot, any other board
+	// into the first empty slot. A full set of slots is never overwritten
+	// without the slot being picked.
+	if (slot != EDITOR_ANY_SLOT) {
+		if (slot >= UPLOAD_SLOTS) return EDIT_NOT_SAVED;
+	}
+	else if (get_game_board_number() > num_levels) {
+		slot = get_game_board_number() - num_levels - 1;
+	}
+	else {
+		slot = 0;
+		while (slot < UPLOAD_SLOTS && upload_slot_length(slot) != 0) {
+			slot++;
+		}
+		if (slot == UPLOAD_SLOTS) return EDIT_SLOTS_FULL;
+	}
+	
+	if (!store_level_slot(slot, level)) return EDIT_NOT_SAVED;
+	
+	*board_num = num_levels + 1 + slot;
+	return EDIT_OK;
+}
@@ -0,0 +1,51 @@
+/*
+ * editor.h
+ *
+ * Created: 17/10/2026 11:12:37 PM
+ *  Author: LiamM
+ */
+
+
+#ifndef EDITOR_H_
+#define EDITOR_H_
+
+#include <stdint.h>
+
+// Results of editor actions
+#define EDIT_OK				0	// Done
+#define EDIT_MARKED			1	// Start marked, move to the end and place again
+#define EDIT_TAKEN			2	// A square of the snake or ladder is already used
+#define EDIT_WRONG_WAY		3	// Snakes must go back along the path, ladders forward
+#define EDIT_TOO_LONG		4	// Not enough body squares left
+#define EDIT_FULL			5	// MAX_LEVEL_LINKS already placed
+#define EDIT_NOTHING		6	// Nothing to delete under the cursor
+#define EDIT_UNREACHABLE	7	// The finish cannot be reached from the start
+#define EDIT_NOT_SAVED		8	// The slot is busy with an upload
+#define EDIT_SLOTS_FULL		9	// No empty slot, one must be picked to replace
+
+// Slot argument of editor_save() to pick the slot automatically
+#define EDITOR_ANY_SLOT		0xFF
+
+// Start editing the current game board, with the cursor on the start square.
+void editor_start(void);
+
+// Move the cursor by (dx, dy), staying on the board.
+void editor_move_cursor(int8_t dx, int8_t dy);
+
+// Flash the cursor on and off, called at a regular interval.
+void editor_flash_cursor(void);
+
+// Place the start or end of a snake (ladder 0) or ladder (ladder 1) at the
+// cursor. The body is drawn as a king-move line between them.
+uint8_t editor_place(uint8_t ladder);
+
+// Delete the snake or ladder under the cursor, or the marked start.
+uint8_t editor_delete(void);
+
+// Check the board can be finished and save it into an upload slot. With
+// EDITOR_ANY_SLOT an uploaded board goes back into its own slot and any other
+// board into an empty slot, or EDIT_SLOTS_FULL is returned if there is none.
+// Returns EDIT_OK and the board number it was saved as in board_num.
+uint8_t editor_save(uint8_t slot, uint8_t* board_num);
+
+#endif /* EDITOR_H_ */
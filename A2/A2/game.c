@@ -9,39 +9,69 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdint.h>
+#include <util/atomic.h>
 #include "game.h"
 #include "display.h"
 #include "prand_number_gen.h"
 #include "gameboard.h"
+#include "levelgen.h"
 #include "buzzer.h"
 #include "animator.h"
-
-static game_board* board;
-
-// The initial game layout. Note that this is laid out in such a way that
-// starting_layout[x][y] does not correspond to an (x,y) coordinate but is a
-// better visual representation (but still somewhat messy).
-// In our reference system, (0,0) is the bottom left, but (0,0) in this array
-// is the top left.
-static game_board_layout* starting_layout;
-
-// The player is not stored in the board itself to avoid overwriting game
-// elements when the player is moved.
-int8_t player_1_x;
-int8_t player_1_y;
-
-// Coordinate position from player 2.
-int8_t player_2_x;
-int8_t player_2_y;
-
-move_buffer player_1_move_buffer[MOVE_BUFFER_SIZE];
-move_buffer player_2_move_buffer[MOVE_BUFFER_SIZE];
-
-int8_t player_1_move_buffer_index;
-int8_t player_2_move_buffer_index;
-
-uint16_t player_1_time;
-uint16_t player_2_time;
+#include "timer0.h"
+
+// The current level, expanded from the level pack by load_level().
+static level_data board;
+
+// Bounded history of moves for undo, stored as compact per-move deltas:
+//   info: player index (bits 0-1), spaces moved by a dice or button move, or
+//         0 for a single step (bits 2-4), snake or ladder taken (bit 5)
+//   from: path index the move started on
+//   to:   path index the move finished on (after any jump)
+// move_history_head is the next entry to write, the oldest entries are
+// overwritten once the history is full.
+#define MOVE_HISTORY_SIZE 16
+#define HISTORY_JUMP_TAKEN 0x20
+
+typedef struct {
+	uint8_t info;
+	square_index from;
+	square_index to;
+} move_history_entry;
+
+static move_history_entry move_history[MOVE_HISTORY_SIZE];
+static uint8_t move_history_head;
+static uint8_t move_history_count;
+
+#if WIDTH != 8
+#error "Bitboards store one uint8_t per row and require WIDTH == 8"
+#endif
+
+// Occupancy of each kind of object, see BITBOARD_* in game.h. The object
+// bitboards are built when the board is loaded, BITBOARD_PLAYERS is kept up
+// to date as players move.
+static bitboard bitboards[NUM_BITBOARDS];
+
+// Bit of a bitboard row holding the square in column x of row y.
+#define BITBOARD_BIT(x, y)	((uint8_t) (1 << (SQUARE_INDEX(x, y) % WIDTH)))
+
+static void build_bitboards(void);
+static void move_player_along_body(uint8_t object, int8_t end_x, int8_t end_y, uint8_t player_num);
+static void update_player_bitboard(int8_t x, int8_t y);
+static void rebuild_player_bitboard(void);
+static void move_player_delta(int8_t dx, int8_t dy, uint8_t player_num);
+static uint8_t move_buffer_length(uint8_t player_num);
+static void record_move(uint8_t player_num, square_index from, uint8_t num_spaces, uint8_t jump_taken);
+static void get_player_shown_position(uint8_t player_num, int8_t* player_x, int8_t* player_y);
+static void update_player_token(uint8_t player_num);
+static void show_players(void);
+
+// State of every player, indexed by PLAYER_INDEX(player_num). Only the first
+// num_players entries take part in the game.
+player_state players[MAX_PLAYERS];
+uint8_t num_players = 1;
+
+// Player whose turn it is.
+uint8_t active_player = PLAYER_1;
 
 // For flashing the player icon
 uint8_t player_visible;
@@ -50,47 +80,153 @@ uint8_t player_visible;
 uint8_t player_turns;
 
 uint8_t game_board_number = GAMEBOARD_1;
+
+// Seed and size of the board built when game_board_number is GAMEBOARD_GENERATED
+uint16_t generated_seed;
+uint8_t generated_snakes = GENERATED_SNAKES;
+uint8_t generated_ladders = GENERATED_LADDERS;
 uint8_t game_time_limit = EASY;
 
 uint8_t game_winner;
 
-uint8_t single_player_flag = 1;
+// Set when a player reaches the finish or runs out of time. Raised from the
+// places that change those conditions so the main loop only reads a flag.
+uint8_t game_over_flag;
+
+// Time limit in ms, only used when game_time_limit is not EASY.
+uint32_t game_time_limit_ms;
+
+// Only the active player's clock runs. It has been running since
+// timer_start_time, which is reset whenever the clock is stopped or switched
+// so pauses and turn changes are accounted for exactly.
+uint8_t timed_player = PLAYER_1;
+uint32_t timer_start_time;
+uint8_t timer_paused;
+
+static void raise_game_over(uint8_t winner);
+static void set_active_player(uint8_t player_num);
+static uint32_t get_player_elapsed_time(uint8_t player_index);
+static void reset_player_timers(void);
+static uint8_t get_furthest_player(uint8_t excluded_player_num);
 
 void init_game() {		
 	// start the player icon at the bottom left of the display
 	// NOTE: (for INternal students) the LED matrix uses a different coordinate
 	// system
-
-	init_player();
 	
-	update_square_colour(player_1_x, player_1_y, PLAYER_1);
-		
-	if (!single_player_flag) update_square_colour(player_2_x, player_2_y, PLAYER_2);
+	init_player();
+	show_players();
 }
 
 void init_player() {
-	player_1_x = 0;
-	player_1_y = 0;
+	for (uint8_t i = 0; i < MAX_PLAYERS; i++) {
+		players[i].x = 0;
+		players[i].y = 0;
+	}
+	reset_player_timers();
 	
-	player_2_x = 0;
-	player_2_y = 0;
+	rebuild_player_bitboard();
 	
-	player_1_time = 0;
-	player_2_time = 0;
+	move_history_head = 0;
+	move_history_count = 0;
 	
 	player_visible = 0;
 	player_turns = 0;
+	active_player = PLAYER_1;
+	timed_player = PLAYER_1;
+	
+	game_over_flag = 0;
+	game_winner = 0;
 	
-	player_1_move_buffer_index = 0;
-	player_2_move_buffer_index = 0;
+	move_buffer_reset();
 }
 
 void init_game_board(uint8_t game_board_num) {
 	// initialise the display we are using.
 	initialise_display();
 	
-	starting_layout = get_game_starting_layout(game_board_num);
-	board = get_game_board(starting_layout);
+	if (game_board_num == GAMEBOARD_GENERATED) {
+		// The object bitboards are rebuilt from the board below, so the
+		// generator can use two of them as scratch.
+		generate_level(generated_seed, generated_snakes, generated_ladders, &board, &bitboards[BITBOARD_SNAKES]);
+	}
+	else if (!load_level(game_board_num, &board)) {
+		game_board_num = GAMEBOARD_1;
+		load_level(game_board_num, &board);
+	}
+	game_board_number = game_board_num;
+	display_redraw();
+	
+	build_bitboards();
+}
+
+// Fill the object bitboards for the current board.
+static void build_bitboards(void) {
+	for (uint8_t y = 0; y < HEIGHT; y++) {
+		for (uint8_t i = 0; i < BITBOARD_PLAYERS; i++) {
+			bitboards[i][y] = 0;
+		}
+		
+		for (uint8_t x = 0; x < WIDTH; x++) {
+			uint8_t object_type = get_object_type_at(x, y);
+			uint8_t bit = BITBOARD_BIT(x, y);
+			
+			if (object_type == SNAKE_START) bitboards[BITBOARD_SNAKES][y] |= bit;
+			else if (object_type == LADDER_START) bitboards[BITBOARD_LADDERS][y] |= bit;
+			else if (object_type == FINISH_LINE) bitboards[BITBOARD_FINISH][y] |= bit;
+		}
+	}
+}
+
+// Recompute the player bitboard bit for (x, y) from the player positions.
+static void update_player_bitboard(int8_t x, int8_t y) {
+	uint8_t bit = BITBOARD_BIT(x, y);
+	
+	bitboards[BITBOARD_PLAYERS][y] &= ~bit;
+	
+	for (uint8_t i = 0; i < num_players; i++) {
+		if (players[i].x == x && players[i].y == y) {
+			bitboards[BITBOARD_PLAYERS][y] |= bit;
+			break;
+		}
+	}
+}
+
+// Rebuild the whole player bitboard from the player positions.
+static void rebuild_player_bitboard(void) {
+	for (uint8_t y = 0; y < HEIGHT; y++) {
+		bitboards[BITBOARD_PLAYERS][y] = 0;
+	}
+	
+	for (uint8_t i = 0; i < num_players; i++) {
+		update_player_bitboard(players[i].x, players[i].y);
+	}
+}
+
+// Return 1 if the square (x, y) is set in the given bitboard, 0 otherwise.
+uint8_t bitboard_test(uint8_t bitboard_num, int8_t x, int8_t y) {
+	if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT) return 0;
+	
+	return (bitboards[bitboard_num][y] & BITBOARD_BIT(x, y)) != 0;
+}
+
+// Return the bits of the given bitboard for the num_squares (at most 8)
+// squares following path index square. Bit 0 is the next square, squares past
+// the end of the board read as 0.
+uint8_t bitboard_ahead(uint8_t bitboard_num, square_index square, uint8_t num_squares) {
+	square_index next = square + 1;
+	uint8_t row = next / WIDTH;
+	uint16_t window = 0;
+	
+	if (row < HEIGHT) window = bitboards[bitboard_num][row];
+	if (row + 1 < HEIGHT) window |= (uint16_t) bitboards[bitboard_num][row + 1] << WIDTH;
+	
+	return (window >> (next % WIDTH)) & (uint8_t) ((1 << num_squares) - 1);
+}
+
+// Return row y of the given bitboard.
+uint8_t bitboard_row(uint8_t bitboard_num, uint8_t y) {
+	return bitboards[bitboard_num][y];
 }
 
 // Return the game object at the specified position (x, y). This function does
@@ -103,8 +239,17 @@ uint8_t get_object_at(uint8_t x, uint8_t y) {
 		return EMPTY_SQUARE;
 	} else {
 		//if in the bounds, just index into the array
-		return *(*(board + x) + y);
+		return level_object_at(&board, x, y);
+	}
+}
+
+// Return the object type at (x, y), as get_object_type(get_object_at(x, y))
+// but without finding the identifier, for drawing the board.
+uint8_t get_object_type_at(uint8_t x, uint8_t y) {
+	if (x >= WIDTH || y >= HEIGHT) {
+		return EMPTY_SQUARE;
 	}
+	return level_type_at(&board, x, y);
 }
 
 // Extract the object type of a game element (the upper 4 bits).
@@ -124,55 +269,110 @@ void move_player_n(uint8_t num_spaces, uint8_t player_num) {
 	int8_t player_x, player_y;
 	get_player_n_position(player_num, &player_x, &player_y);
 	
-	move_buffer_add(player_x, player_y, player_num);
-	
-	//uint8_t object_at_cursor = get_object_at_cursor(player_x, player_y, player_num);
-	//update_square_colour(player_x, player_y, object_at_cursor);
+	// Jump straight to the target square along the path. Any snake or ladder
+	// there is taken by handle_player_collision() below.
+	square_index start = SQUARE_INDEX(player_x, player_y);
+	square_index target = roll_destination(start, num_spaces, NULL);
 	
-	for(int moves = 0; moves < num_spaces; moves++) {
-		// Player is on odd row move left.
-		if (player_y % 2) {
-			if (player_x - 1 >= 0) player_x--;
-			else player_y++;
-		}
-		// Player is on even row move right.
-		else {
-			if (player_x + 1 < WIDTH) player_x++;
-			else player_y++;
-		}
-		
-		if (player_y >= HEIGHT) {
-			player_y = HEIGHT - 1; //Move player to top row
-			player_x = (WIDTH - 1) * !((HEIGHT - 1) % 2); //Move player to top corner depending on odd/even row.
-			break;
-		}
-		
-		move_buffer_add(player_x, player_y, player_num);
+	// Queue every square passed through for the move animation.
+	for (square_index square = start; ; square++) {
+		move_buffer_add(SQUARE_INDEX_X(square), SQUARE_INDEX_Y(square), player_num);
+		if (square == target) break;
 	}
 	
-	// Player is outside bounds, move to correct top corner.
-	if (player_y < HEIGHT) player_turns_inc(1);
+	player_x = SQUARE_INDEX_X(target);
+	player_y = SQUARE_INDEX_Y(target);
+	
+	player_turns_inc(1);
 	
 	play_sound(move_sound);
 	set_player_n_position(player_num, player_x, player_y);
 	
 	set_move_anim();
 	
-	handle_player_collision(player_x, player_y, player_num);
+	uint8_t jump_taken = handle_player_collision(player_x, player_y, player_num);
+	record_move(player_num, start, num_spaces, jump_taken);
 }
 
 // Move the player one space in the direction (dx, dy). The player should wrap
 // around the display if moved 'off' the display. Returns 1 if player collided with snake or ladder
 uint8_t move_player(int8_t dx, int8_t dy, uint8_t player_num, uint8_t sound_flag) {
 	int8_t player_x, player_y;
+	
+	get_player_n_position(player_num, &player_x, &player_y);
+	square_index start = SQUARE_INDEX(player_x, player_y);
+	
+	move_player_delta(dx, dy, player_num);
+	
+	if(sound_flag) play_sound(move_sound);
+	
+	get_player_n_position(player_num, &player_x, &player_y);
+	
+	uint8_t jump_taken = handle_player_collision(player_x, player_y, player_num);
+	record_move(player_num, start, 0, jump_taken);
+	
+	return jump_taken;
+}
+
+// Add a finished move to the move history. The destination is the player's
+// current square.
+static void record_move(uint8_t player_num, square_index from, uint8_t num_spaces, uint8_t jump_taken) {
+	move_history_entry* entry = &move_history[move_history_head];
+	int8_t player_x, player_y;
+	
+	get_player_n_position(player_num, &player_x, &player_y);
+	
+	entry->info = PLAYER_INDEX(player_num) | ((num_spaces & 0x07) << 2) | (jump_taken ? HISTORY_JUMP_TAKEN : 0);
+	entry->from = from;
+	entry->to = SQUARE_INDEX(player_x, player_y);
+	
+	move_history_head = (move_history_head + 1) % MOVE_HISTORY_SIZE;
+	if (move_history_count < MOVE_HISTORY_SIZE) move_history_count++;
+}
+
+// Undo the most recent move in the history. The player who made it is moved
+// back to where it started and it becomes their turn again. Returns 1 if a
+// move was undone, 0 if the history is empty.
+uint8_t undo_move(void) {
+	if (move_history_count == 0) return 0;
+	
+	move_history_head = (move_history_head + MOVE_HISTORY_SIZE - 1) % MOVE_HISTORY_SIZE;
+	move_history_count--;
+	
+	move_history_entry* entry = &move_history[move_history_head];
+	uint8_t player_num = PLAYER_NUM(entry->info & 0x03);
+	int8_t player_x, player_y;
+	
+	// Abandon any animation still playing for the move. The interrupt
+	// normally owns the head of the queue, so keep it out.
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		while (move_buffer_length(player_num) > 0) {
+			move_buffer_remove(player_num);
+		}
+	}
+	
+	player_x = SQUARE_INDEX_X(entry->from);
+	player_y = SQUARE_INDEX_Y(entry->from);
+	set_player_n_position(player_num, player_x, player_y);
+	update_player_token(player_num);
+	
+	// Only dice and button moves count as a turn.
+	if ((entry->info >> 2) & 0x07) player_turns--;
+	
+	set_active_player(player_num);
+	
+	return 1;
+}
+
+// Move the player by (dx, dy) without checking for collisions. Deltas larger
+// than one square are animated through the intermediate squares.
+static void move_player_delta(int8_t dx, int8_t dy, uint8_t player_num) {
+	int8_t player_x, player_y;
 	int8_t temp_dx = 0;
 	int8_t temp_dy = 0;
 	
 	get_player_n_position(player_num, &player_x, &player_y);
 	
-	uint8_t object_at_cursor = get_object_at_cursor(player_x, player_y, player_num);
-	update_square_colour(player_x, player_y, object_at_cursor);
-	
 	// Player has move delta more than 1 position
 	if (abs(dx) > 1 || abs(dy) > 1) {
 		move_buffer_add(player_x, player_y, player_num);
@@ -194,24 +394,19 @@ uint8_t move_player(int8_t dx, int8_t dy, uint8_t player_num, uint8_t sound_flag
 			move_buffer_add(temp_x, temp_y, player_num);
 		}
 	}
-
+	
 	player_x += dx;
 	player_y += dy;
 	
 	move_player_constrain(&player_x, &player_y);
 	
-	if(sound_flag) play_sound(move_sound);
-	
 	set_player_n_position(player_num, player_x, player_y);
 	
-	// Instantly move player if move delta is 1
-	if (abs(dx) == 1 || abs(dy) == 1) {
-		update_square_colour(player_x, player_y, player_num);
-	}
-
-	set_move_anim();
+	// The token moves at once if move delta is 1, otherwise it waits at the
+	// start of the animation
+	update_player_token(player_num);
 	
-	return handle_player_collision(player_x, player_y, player_num);
+	set_move_anim();
 }
 
 // Stop player exceeding screen bounds
@@ -226,7 +421,7 @@ void move_player_constrain(int8_t *player_x, int8_t *player_y) {
 	else if (y_pos < 0) {
 		*player_y = HEIGHT + y_pos; //Move player to bottom row.
 	}
-		
+	
 	if (x_pos >= WIDTH) {
 		*player_x = WIDTH - x_pos; //Move player to left column.
 	}
@@ -235,130 +430,89 @@ void move_player_constrain(int8_t *player_x, int8_t *player_y) {
 	}
 }
 
+// Return the move queue for a given player
+static move_queue* get_move_queue(uint8_t player_num) {
+	return &players[PLAYER_INDEX(player_num)].moves;
+}
+
+// Return the number of squares waiting in a player's move queue
+static uint8_t move_buffer_length(uint8_t player_num) {
+	move_queue* queue = get_move_queue(player_num);
+	return (uint8_t) (queue->tail - queue->head);
+}
+
 // Reset move animation buffer
 void move_buffer_reset(void) {
-	for (uint8_t i = 0; i < MOVE_BUFFER_SIZE; i++) {
-		player_1_move_buffer[i][0] = 0;
-		player_1_move_buffer[i][1] = 0;
+	// The animation interrupt owns head, keep it out while both ends move.
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		for (uint8_t i = 0; i < MAX_PLAYERS; i++) {
+			players[i].moves.head = players[i].moves.tail = 0;
+			players[i].moves.overflow = 0;
+		}
 	}
 }
 
 // Return (x,y) coordinate from topmost element of move buffer
 void get_move_buffer(int8_t *player_x, int8_t *player_y, uint8_t player_num) {
-	switch (player_num) {
-		case PLAYER_1:
-		// Add player 1 position to bottom of buffer
-		*player_x = player_1_move_buffer[0][0];
-		*player_y = player_1_move_buffer[0][1];
-		break;
-		case PLAYER_2:
-		// Add player 2 position to bottom of buffer
-		*player_x = player_2_move_buffer[0][0];
-		*player_y = player_2_move_buffer[0][1];
-		break;
-	}
+	move_queue* queue = get_move_queue(player_num);
+	uint8_t index = queue->head & (MOVE_BUFFER_SIZE - 1);
+	
+	*player_x = queue->squares[index][0];
+	*player_y = queue->squares[index][1];
 }
 
-// Add new (x,y) coordinate to bottom of move buffer
+// Add new (x,y) coordinate to bottom of move buffer. Only called from the
+// main loop, which owns the tail of the queue.
 void move_buffer_add(int8_t player_x, int8_t player_y, uint8_t player_num) {
-	int8_t temp_x, temp_y;
-	
-	if (player_2_move_buffer_index >= MOVE_BUFFER_SIZE - 1 ||
-		player_1_move_buffer_index >= MOVE_BUFFER_SIZE - 1) {
-		get_move_buffer(&temp_x, &temp_y, player_num);
-		uint8_t object_at_cursor = get_object_at_cursor(temp_x, temp_y, player_num);
-		update_square_colour(temp_x, temp_y, object_at_cursor);
-		move_buffer_remove(player_num);
-	}
-	
-	switch (player_num) {
-		case PLAYER_1:
-			// Add player 1 position to bottom of buffer
-			player_1_move_buffer[player_1_move_buffer_index][0] = player_x;
-			player_1_move_buffer[player_1_move_buffer_index][1] = player_y;
-			player_1_move_buffer_index++;
-			break;
-		case PLAYER_2:
-			// Add player 2 position to bottom of buffer
-			player_2_move_buffer[player_2_move_buffer_index][0] = player_x;
-			player_2_move_buffer[player_2_move_buffer_index][1] = player_y;
-			player_2_move_buffer_index++;
-			break;
+	move_queue* queue = get_move_queue(player_num);
+	
+	// The queue is full, drop the new square. The animation still finishes on
+	// the player's real position, it just skips part of the path.
+	if (move_buffer_length(player_num) >= MOVE_BUFFER_SIZE) {
+		if (queue->overflow < 255) queue->overflow++;
+		return;
 	}
+	
+	uint8_t index = queue->tail & (MOVE_BUFFER_SIZE - 1);
+	
+	queue->squares[index][0] = player_x;
+	queue->squares[index][1] = player_y;
+	
+	// The square must be stored before the interrupt can see it.
+	__asm__ __volatile__ ("" ::: "memory");
+	queue->tail++;
 }
 
-
-// Remove topmost element of move buffer
+// Remove topmost element of move buffer. Only called from the animation
+// interrupt, which owns the head of the queue.
 void move_buffer_remove(uint8_t player_num) {
-	switch (player_num) {
-		case PLAYER_1:
-		// Remove player 1 position from top of buffer
-		for (uint8_t i = 0; i < player_1_move_buffer_index; i++) {
-				player_1_move_buffer[i][0] = player_1_move_buffer[i+1][0];
-				player_1_move_buffer[i][1] = player_1_move_buffer[i+1][1];
-		}
-		player_1_move_buffer_index --;
-		break;
-		case PLAYER_2:
-		// Remove player 2 position from top of buffer
-		for (uint8_t i = 0; i < player_2_move_buffer_index; i++) {
-			player_2_move_buffer[i][0] = player_2_move_buffer[i+1][0];
-			player_2_move_buffer[i][1] = player_2_move_buffer[i+1][1];
-		}
-		player_2_move_buffer_index --;
-		break;
-	}
+	move_queue* queue = get_move_queue(player_num);
+	
+	if (queue->tail != queue->head) queue->head++;
 }
 
-// Animate the movement of players
-void move_anim(void) {
-	int8_t pixel_x, pixel_y;
-	
-	if(player_1_move_buffer_index > 0) {
-		get_move_buffer(&pixel_x, &pixel_y, PLAYER_1);
+// Return the number of squares dropped from a player's move buffer because it was full
+uint8_t get_move_buffer_overflow(uint8_t player_num) {
+	return get_move_queue(player_num)->overflow;
+}
 
-		// Set previous position to default board object
-		uint8_t object_at_cursor = get_object_at_cursor(pixel_x, pixel_y, PLAYER_1);
-		update_square_colour(pixel_x, pixel_y, object_at_cursor);
-			
-		move_buffer_remove(PLAYER_1);
-		set_player_visibility(1, PLAYER_1);
-	}
-	
-	if(player_2_move_buffer_index > 0) {
-		get_move_buffer(&pixel_x, &pixel_y, PLAYER_2);
-		
-		// Set previous position to default board object
-		uint8_t object_at_cursor = get_object_at_cursor(pixel_x, pixel_y, PLAYER_2);
-		update_square_colour(pixel_x, pixel_y, object_at_cursor);
+// Animate the movement of players, stepping each token to the next square of
+// its move
+void move_anim(void) {
+	for (uint8_t i = 0; i < num_players; i++) {
+		uint8_t player_num = PLAYER_NUM(i);
 		
-		move_buffer_remove(PLAYER_2);
-		set_player_visibility(1, PLAYER_2);	
-	}
-	
-	if(player_1_move_buffer_index > 1) {
-		// Set current position to player 
-		get_move_buffer(&pixel_x, &pixel_y, PLAYER_1);
-		update_square_colour(pixel_x, pixel_y, PLAYER_1);
-	} 
-	
-	if(player_2_move_buffer_index > 1) {	
-		// Set current position to player
-		get_move_buffer(&pixel_x, &pixel_y, PLAYER_2);	
-		update_square_colour(pixel_x, pixel_y, PLAYER_2);
+		if(move_buffer_length(player_num) > 0) {
+			move_buffer_remove(player_num);
+			update_player_token(player_num);
+			set_player_visibility(1, player_num);
+		}
 	}
 }
 
 // Return 1 if move anim is playing
 uint8_t get_move_anim_playing(uint8_t player_num) {
-	switch (player_num) {
-		case PLAYER_1:
-			return (player_1_move_buffer_index > 1);
-		case PLAYER_2:
-			return (player_2_move_buffer_index > 1);
-		default:
-			return 0;
-	}
+	return (move_buffer_length(player_num) > 1);
 }
 
 // Flash the selected player icon on and off. This should be called at a regular
@@ -366,42 +520,20 @@ uint8_t get_move_anim_playing(uint8_t player_num) {
 // 500 ms flash.
 void flash_player_cursor(uint8_t player_num) {
 	if (get_move_anim_playing(player_num)) return;
-		
-	int8_t player_x, player_y;
-
-	get_player_n_position(player_num, &player_x, &player_y);
 	
-	if (player_visible) {
-		// we need to flash the player off, it should be replaced by
-		// the colour of the object which is at that location
-		uint8_t object_at_cursor = get_object_at_cursor(player_x, player_y, player_num);
-		
-		update_square_colour(player_x, player_y, object_at_cursor);
-		
-	} else {
-		// we need to flash the player on
-		update_square_colour(player_x, player_y, player_num);
-	}
 	player_visible = 1 - player_visible; //alternate between 0 and 1
+	
+	// Whatever the token covers (the board or another player) shows
+	// through while it is off
+	display_show_token(player_num, player_visible);
 }
 
 // Set the visibility of the player icon.
 void set_player_visibility(uint8_t visible, uint8_t player_num) {
 	if (get_move_anim_playing(player_num)) return;
 	
-	int8_t player_x, player_y;
-	
-	get_player_n_position(player_num, &player_x, &player_y);
-	
 	player_visible = visible;
-	
-	if (player_visible) {
-		update_square_colour(player_x, player_y, player_num);
-	} 
-	else {
-		uint8_t object_at_cursor = get_object_at(player_x, player_y);
-		update_square_colour(player_x, player_y, object_at_cursor);
-	}
+	display_show_token(player_num, player_visible);
 }
 
 // Return the current number of turns.
@@ -438,38 +570,53 @@ uint8_t handle_player_collision(int8_t player_x, int8_t player_y, uint8_t player
 	dx = x - player_x;
 	dy = y - player_y;
 	
+	// The destination table already resolves chained jumps, so the final
+	// square is reached in a single move.
 	if (dx != 0 || dy != 0) {
-		move_player(dx, dy, player_num, 0);
+		move_player_along_body(object_at_cursor, x, y, player_num);
 		return 1;
 	}
 	return 0;
 }
 
+// Animate the player down a snake or up a ladder, following the body given
+// by the level, and finish on (end_x, end_y).
+static void move_player_along_body(uint8_t object, int8_t end_x, int8_t end_y, uint8_t player_num) {
+	uint8_t identifier = get_object_identifier(object);
+	level_link link;
+	int8_t player_x, player_y;
+	
+	get_player_n_position(player_num, &player_x, &player_y);
+	
+	if (!level_get_link(&board, identifier, &link) || link.body_length == 0) {
+		move_player_delta(end_x - player_x, end_y - player_y, player_num);
+		return;
+	}
+	
+	move_buffer_add(player_x, player_y, player_num);
+	for (uint8_t i = 0; i < link.body_length; i++) {
+		packed_square square = level_body_square(&board, identifier, i);
+		move_buffer_add(UNPACK_SQUARE_X(square), UNPACK_SQUARE_Y(square), player_num);
+	}
+	move_buffer_add(end_x, end_y, player_num);
+	
+	set_player_n_position(player_num, end_x, end_y);
+	update_player_token(player_num);
+	set_move_anim();
+}
+
 // Returns the object type hit and pointers to the coordinates (end_x, end_y) corresponding to the end of an object collision.
+// On entry (end_x, end_y) must hold the square the object was found at.
 uint8_t collision_object_coords(uint8_t object, int8_t* end_x, int8_t* end_y) {
-	uint8_t object_identifier = get_object_identifier(object);
 	uint8_t object_type = get_object_type(object);
 	
 	if (object_type == SNAKE_START || object_type == LADDER_START) {
-
-		uint8_t loop_break_flag = 0;
+		level_link link;
 		
-		// Iterate over every board object and determine if it is the end of a given object.
-		for (int x = 0; x < WIDTH; x++) {
-			for (int y = 0; y < HEIGHT; y++) {
-				uint8_t board_object = get_object_at(x, y);
-				uint8_t board_object_identifier = get_object_identifier(board_object);
-				uint8_t board_object_type = get_object_type(board_object);
-				
-				// Determine if object at (x,y) is the corresponding end element (i.e start_object_type + 0x10) for a given identifier.
-				if((object_type + 0x10) == board_object_type && object_identifier == board_object_identifier) {
-					*end_x = x;
-					*end_y = y;
-					loop_break_flag = 1;
-					break;
-				}
-			}
-			if (loop_break_flag) break;
+		// A start without a link does not move the player.
+		if (level_get_link(&board, get_object_identifier(object), &link)) {
+			*end_x = UNPACK_SQUARE_X(link.destination);
+			*end_y = UNPACK_SQUARE_Y(link.destination);
 		}
 	}
 	
@@ -478,76 +625,126 @@ uint8_t collision_object_coords(uint8_t object, int8_t* end_x, int8_t* end_y) {
 
 // Get the coordinates for a given player
 void get_player_n_position(uint8_t player_num, int8_t* player_x, int8_t* player_y) {
-	switch (player_num) {
-		case PLAYER_1:
-			*player_x = player_1_x;
-			*player_y = player_1_y;
-			break;
-		case PLAYER_2:
-			*player_x = player_2_x;
-			*player_y = player_2_y;
-			break;
-	}
+	player_state* player = &players[PLAYER_INDEX(player_num)];
+	
+	*player_x = player->x;
+	*player_y = player->y;
 }
 
 // Set the coordinates for a given player
 void set_player_n_position(uint8_t player_num, int8_t player_x, int8_t player_y) {
-	switch (player_num) {
-		case PLAYER_1:
-			player_1_x = player_x;
-			player_1_y = player_y;
-			break;
-		case PLAYER_2:
-			player_2_x = player_x;
-			player_2_y = player_y;
-			break;
+	player_state* player = &players[PLAYER_INDEX(player_num)];
+	int8_t old_x = player->x;
+	int8_t old_y = player->y;
+	
+	player->x = player_x;
+	player->y = player_y;
+	
+	update_player_bitboard(old_x, old_y);
+	update_player_bitboard(player_x, player_y);
+	
+	if (bitboard_test(BITBOARD_FINISH, player_x, player_y)) {
+		raise_game_over(player_num);
 	}
 }
 
-// Get object or player at (x,y) coordinate
-uint8_t get_object_at_cursor(int8_t player_x, int8_t player_y, uint8_t player_num) {
-	if (((player_x == player_2_x && player_y == player_2_y && player_num != PLAYER_2) ||
-		(player_x == player_1_x && player_y == player_1_y && player_num != PLAYER_1)) &&
-		!single_player_flag) {
-		return handle_player_num_change(player_num);
+// Return where a player is shown: the head of its move animation while one is
+// playing, otherwise its position.
+static void get_player_shown_position(uint8_t player_num, int8_t* player_x, int8_t* player_y) {
+	if (get_move_anim_playing(player_num)) {
+		get_move_buffer(player_x, player_y, player_num);
 	}
 	else {
-		return get_object_at(player_x, player_y);
+		get_player_n_position(player_num, player_x, player_y);
+	}
+}
+
+// Move a player's token to where it is shown
+static void update_player_token(uint8_t player_num) {
+	int8_t player_x, player_y;
+	
+	// The interrupt may step the animation in between
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		get_player_shown_position(player_num, &player_x, &player_y);
+		display_place_token(player_num, player_x, player_y);
+	}
+}
+
+// Put every player's token on the board
+static void show_players(void) {
+	for (uint8_t i = 0; i < num_players; i++) {
+		update_player_token(PLAYER_NUM(i));
+		display_show_token(PLAYER_NUM(i), 1);
+	}
+}
+
+// Keep the player being watched in view
+void follow_players(void) {
+	uint8_t player_num = active_player;
+	int8_t player_x, player_y;
+	
+	for (uint8_t i = 0; i < num_players; i++) {
+		if (get_move_anim_playing(PLAYER_NUM(i))) {
+			player_num = PLAYER_NUM(i);
+			break;
+		}
 	}
+	
+	get_player_shown_position(player_num, &player_x, &player_y);
+	display_follow_row(player_y);
 }
 
 // Return the next player number
 uint8_t handle_player_num_change(uint8_t player_num) {
-	switch (player_num) {
-		case PLAYER_1:
-			return PLAYER_2;
-		case PLAYER_2:
-			return PLAYER_1;
-		default:
-			return player_num;	
-	}
+	return PLAYER_NUM((PLAYER_INDEX(player_num) + 1) % num_players);
 }
 
-// Change game boards, return selected board number
+// Change to the next game board in the level pack or the upload slots,
+// skipping empty slots. Return selected board number
 uint8_t handle_game_board_num_change() {
-	switch (game_board_number) {
-		case  GAMEBOARD_1:
-			game_board_number = GAMEBOARD_2;
-			break;
-		case GAMEBOARD_2:
+	do {
+		if (game_board_number >= get_num_boards()) {
 			game_board_number = GAMEBOARD_1;
-			break;
-	}
+		}
+		else {
+			game_board_number++;
+		}
+	} while (!load_level(game_board_number, NULL));
 	
 	play_sound(button_sound);
 	return game_board_number;
 }
 
+// Select a generated board. Returns the board number to pass to init_game_board().
+uint8_t set_generated_board(uint16_t seed, uint8_t num_snakes, uint8_t num_ladders) {
+	generated_seed = seed;
+	generated_snakes = num_snakes;
+	generated_ladders = num_ladders;
+	game_board_number = GAMEBOARD_GENERATED;
+	
+	return game_board_number;
+}
+
+// Return the number of the current board.
+uint8_t get_game_board_number(void) {
+	return game_board_number;
+}
+
+// Return the current board, for the editor to change in place.
+level_data* get_game_board(void) {
+	return &board;
+}
+
+// Return the seed of the generated board.
+uint16_t get_generated_seed(void) {
+	return generated_seed;
+}
+
 // Set the game difficulty (easy/medium/hard)
 void set_game_difficulty(uint8_t game_difficulty_num) {
-	player_1_time = 0;
-	player_2_time = 0;
+	reset_player_timers();
 	game_time_limit = game_difficulty_num;
+	game_time_limit_ms = game_difficulty_num * 1000UL;
 	play_sound(button_sound);
 }
 
@@ -556,50 +753,227 @@ uint8_t get_game_difficulty(void) {
 	return game_time_limit;
 }
 
-// Set the current game mode (multi/single player)
-void set_single_player(uint8_t player_flag) {
-	single_player_flag = player_flag;
+// Set the number of players in the game
+void set_num_players(uint8_t player_count) {
+	if (player_count < 1) player_count = 1;
+	if (player_count > MAX_PLAYERS) player_count = MAX_PLAYERS;
+	
+	num_players = player_count;
 	play_sound(button_sound);
 }
 
+// Get the number of players in the game
+uint8_t get_num_players(void) {
+	return num_players;
+}
+
 // Get the current game mode (multi/single player)
 uint8_t get_single_player(void) {
-	return single_player_flag;
+	return (num_players == 1);
+}
+
+// Return the time used by a player in ms, including any running interval
+static uint32_t get_player_elapsed_time(uint8_t player_index) {
+	uint32_t elapsed = players[player_index].time_used;
+	
+	if (PLAYER_NUM(player_index) == timed_player && !timer_paused) {
+		elapsed += get_current_time() - timer_start_time;
+	}
+	
+	return elapsed;
+}
+
+// Clear every player's time and restart the running clock
+static void reset_player_timers(void) {
+	for (uint8_t i = 0; i < MAX_PLAYERS; i++) {
+		players[i].time_used = 0;
+	}
+	timer_start_time = get_current_time();
+	timer_paused = 0;
 }
 
-//Update player timer
+// Return the player time in 10 ms units
 uint16_t update_player_time(uint8_t player_num) {
-	switch (player_num) {
-		case PLAYER_1:
-			player_1_time ++;
-			return player_1_time;
-		case PLAYER_2:
-			player_2_time ++;
-			return player_2_time;
-		default:
-			return 0;
+	uint32_t elapsed = get_player_elapsed_time(PLAYER_INDEX(player_num));
+	
+	// A player running out of time hands the win to whoever of the others
+	// is furthest along the path.
+	if (game_time_limit != EASY && elapsed >= game_time_limit_ms) {
+		raise_game_over(get_furthest_player(player_num));
 	}
+	
+	if (elapsed >= 655350UL) return 65535;
+	return elapsed / 10;
 }
 
-// Returns 1 if the game is over, 0 otherwise.
-uint8_t is_game_over(void) {
-	// Detect if the game is over i.e. if a player has won.
-	uint8_t object_at_cursor_p1 = get_object_type(get_object_at(player_1_x, player_1_y));
-	uint8_t object_at_cursor_p2 = get_object_type(get_object_at(player_2_x, player_2_y));
+// Stop (1) or restart (0) the running player timer
+void pause_player_timer(uint8_t pause_flag) {
+	uint32_t current_time = get_current_time();
 	
-	if (object_at_cursor_p1 == FINISH_LINE || (player_2_time >= game_time_limit * 100 && game_time_limit != EASY)) {
-		game_winner = PLAYER_1;
-		return 1;
+	if (pause_flag == timer_paused) return;
+	
+	if (pause_flag) {
+		players[PLAYER_INDEX(timed_player)].time_used += current_time - timer_start_time;
 	}
-	else if (object_at_cursor_p2 == FINISH_LINE || (player_1_time >= game_time_limit * 100 && game_time_limit != EASY)) {
-		game_winner = PLAYER_2;
-		return 1;
+	timer_start_time = current_time;
+	timer_paused = pause_flag;
+}
+
+// Hand the turn, and the running clock, to the given player
+static void set_active_player(uint8_t player_num) {
+	uint32_t current_time = get_current_time();
+	
+	if (!timer_paused) {
+		players[PLAYER_INDEX(timed_player)].time_used += current_time - timer_start_time;
+	}
+	timer_start_time = current_time;
+	timed_player = player_num;
+	active_player = player_num;
+}
+
+// Return the player whose turn it is.
+uint8_t get_active_player(void) {
+	return active_player;
+}
+
+// Pass the turn to the next player and return them.
+uint8_t next_active_player(void) {
+	set_active_player(handle_player_num_change(active_player));
+	return active_player;
+}
+
+// Write the game state into buffer. Layout:
+//   0: board number
+//   1: difficulty (time limit in seconds)
+//   2: player count - 1 (bits 0-1), active player index (bits 2-3),
+//      game over (bit 4)
+//   3: turns
+//   4: winner
+//   5-6: generated board seed (little endian)
+//   7: generated board snakes (bits 4-7) and ladders (bits 0-3)
+//   8: level_checksum() of the board (0 for a generated board)
+//   9: player 1 path index (two bytes, little endian, on boards of more than
+//      256 squares), then player 1 time in 10 ms units (little endian),
+//      repeated for each player in the game.
+uint8_t pack_game_state(uint8_t* buffer) {
+	uint8_t length = GAME_STATE_HEADER_SIZE;
+	
+	buffer[0] = game_board_number;
+	buffer[1] = game_time_limit;
+	buffer[2] = (num_players - 1) | (PLAYER_INDEX(active_player) << 2) | (game_over_flag << 4);
+	buffer[3] = player_turns;
+	buffer[4] = game_winner;
+	buffer[5] = generated_seed & 0xFF;
+	buffer[6] = generated_seed >> 8;
+	buffer[7] = (generated_snakes << 4) | (generated_ladders & 0x0F);
+	buffer[8] = (game_board_number == GAMEBOARD_GENERATED) ? 0 : level_checksum(game_board_number);
+	
+	for (uint8_t i = 0; i < num_players; i++) {
+		uint16_t time = update_player_time(PLAYER_NUM(i));
+		
+		square_index square = SQUARE_INDEX(players[i].x, players[i].y);
+		
+		buffer[length++] = square & 0xFF;
+#if BOARD_SQUARES > 256
+		buffer[length++] = square >> 8;
+#endif
+		buffer[length++] = time & 0xFF;
+		buffer[length++] = time >> 8;
 	}
 	
-	return 0;
+	return length;
+}
+
+// Read a path index written by pack_game_state().
+static square_index read_square_index(const uint8_t* buffer) {
+#if BOARD_SQUARES > 256
+	return (uint16_t) buffer[0] | ((uint16_t) buffer[1] << 8);
+#else
+	return buffer[0];
+#endif
+}
+
+// Restore the game state written by pack_game_state(). Returns the number of
+// bytes read, or 0 if the data is not valid, in which case nothing is changed.
+uint8_t unpack_game_state(const uint8_t* buffer, uint8_t length) {
+	if (length < GAME_STATE_HEADER_SIZE) return 0;
+	
+	uint8_t player_count = (buffer[2] & 0x03) + 1;
+	uint8_t active_index = (buffer[2] >> 2) & 0x03;
+	uint8_t state_length = GAME_STATE_HEADER_SIZE + GAME_STATE_PLAYER_SIZE * player_count;
+	
+	if (length < state_length || active_index >= player_count) return 0;
+	// The board must still be there, and be the board the game was played on
+	// rather than one uploaded or edited into its slot since.
+	if (buffer[0] != GAMEBOARD_GENERATED
+			&& (!load_level(buffer[0], NULL) || level_checksum(buffer[0]) != buffer[8])) return 0;
+	for (uint8_t i = 0; i < player_count; i++) {
+		if (read_square_index(&buffer[GAME_STATE_HEADER_SIZE + GAME_STATE_PLAYER_SIZE * i]) >= BOARD_SQUARES) return 0;
+	}
+	
+	num_players = player_count;
+	generated_seed = (uint16_t) buffer[5] | ((uint16_t) buffer[6] << 8);
+	generated_snakes = buffer[7] >> 4;
+	generated_ladders = buffer[7] & 0x0F;
+	init_game_board(buffer[0]);
+	init_player();
+	
+	game_time_limit = buffer[1];
+	game_time_limit_ms = game_time_limit * 1000UL;
+	active_player = PLAYER_NUM(active_index);
+	timed_player = active_player;
+	game_over_flag = (buffer[2] >> 4) & 0x01;
+	player_turns = buffer[3];
+	game_winner = buffer[4];
+	
+	for (uint8_t i = 0; i < num_players; i++) {
+		const uint8_t* player = &buffer[GAME_STATE_HEADER_SIZE + GAME_STATE_PLAYER_SIZE * i];
+		square_index square = read_square_index(player);
+		
+		player += sizeof(square_index);
+		players[i].x = SQUARE_INDEX_X(square);
+		players[i].y = SQUARE_INDEX_Y(square);
+		players[i].time_used = ((uint16_t) player[0] | ((uint16_t) player[1] << 8)) * 10UL;
+	}
+	rebuild_player_bitboard();
+	show_players();
+	
+	return state_length;
+}
+
+// Record the end of the game. Only the first event of a game is kept.
+static void raise_game_over(uint8_t winner) {
+	if (game_over_flag) return;
+	
+	game_winner = winner;
+	game_over_flag = 1;
+}
+
+// Return the player furthest along the path, ignoring the given player, or 0
+// if there is nobody else in the game.
+static uint8_t get_furthest_player(uint8_t excluded_player_num) {
+	int16_t furthest_square = -1;
+	uint8_t furthest_player = 0;
+	
+	for (uint8_t i = 0; i < num_players; i++) {
+		int16_t square = SQUARE_INDEX(players[i].x, players[i].y);
+		
+		if (PLAYER_NUM(i) != excluded_player_num && square > furthest_square) {
+			furthest_square = square;
+			furthest_player = PLAYER_NUM(i);
+		}
+	}
+	
+	return furthest_player;
+}
+
+// Returns 1 if the game is over, 0 otherwise. The game over event is raised
+// when a player lands on the finish or runs out of time.
+uint8_t is_game_over(void) {
+	return game_over_flag;
 }
 
-// Returns the game winner's player number
+// Returns the game winner's player number, or 0 if nobody won
 uint8_t get_game_winner(void) {
 	return game_winner;
 }
\ No newline at end of file
@@ -20,11 +20,73 @@
 #define MEDIUM 90
 #define HARD 45
 
-// Game board dimensions
+// Game board dimensions. WIDTH is fixed at the 8 rows of the LED matrix (and
+// one bitboard byte per row). HEIGHT runs along the 16 matrix columns and can
+// be set when building (e.g. -DBOARD_HEIGHT=64 for marathon boards), boards
+// taller than the matrix are shown through a viewport that follows the
+// players. The level pack must be built by levelc for the same height
+// (levels/tall/ holds 64 row levels).
+#ifndef BOARD_HEIGHT
+#define BOARD_HEIGHT 16
+#endif
+
 #define WIDTH  8
-#define HEIGHT 16
+#define HEIGHT BOARD_HEIGHT
+
+#if HEIGHT < 2 || HEIGHT > 64 || (HEIGHT & 1)
+#error "BOARD_HEIGHT must be an even number from 2 to 64"
+#endif
+
+// Squares are numbered 0 to BOARD_SQUARES - 1 along the serpentine path the
+// players follow from the start: even rows run left to right and odd rows run
+// right to left. These convert between a path index and (x, y) in constant
+// time (WIDTH is a power of two so the divisions reduce to shifts and masks).
+// Path indices only need 16 bits on boards of more than 256 squares.
+#define BOARD_SQUARES (WIDTH * HEIGHT)
+#if BOARD_SQUARES > 256
+typedef uint16_t square_index;
+#else
+typedef uint8_t square_index;
+#endif
+#define SQUARE_INDEX(x, y)	((square_index) ((y) * WIDTH + (((y) & 1) ? (WIDTH - 1 - (x)) : (x))))
+#define SQUARE_INDEX_Y(index)	((int8_t) ((index) / WIDTH))
+#define SQUARE_INDEX_X(index)	((int8_t) ((((index) / WIDTH) & 1) ? \
+		(WIDTH - 1 - ((index) % WIDTH)) : ((index) % WIDTH)))
+
+// The movement rule, shared by the game, the editor and levelc so they cannot
+// disagree. Returns the path index a roll of num_spaces from path index square
+// ends on: a move past the last square stops on it, and then jump gives where
+// landing on each square leads (the destination of a snake or ladder starting
+// there, else the square itself). jump may be NULL to leave the jump to the
+// caller, as move_player_n() does so it can be animated.
+static inline square_index roll_destination(square_index square, uint8_t num_spaces, square_index (*jump)(square_index)) {
+	square_index target = BOARD_SQUARES - 1;
+	
+	if (num_spaces < BOARD_SQUARES - 1 - square) target = square + num_spaces;
+	
+	return jump ? jump(target) : target;
+}
+
+// A board square packed as (x << 4) | y in one byte, or (x << 8) | y in two
+// bytes on boards taller than 16 rows. PACKED_SQUARE_BYTES is the size
+// stored in levels.
+#if HEIGHT > 16
+typedef uint16_t packed_square;
+#define PACKED_SQUARE_BYTES	2
+#define PACK_SQUARE(x, y)	((packed_square) (((x) << 8) | (y)))
+#define UNPACK_SQUARE_X(square)	((int8_t) ((square) >> 8))
+#define UNPACK_SQUARE_Y(square)	((int8_t) ((square) & 0xFF))
+#else
+typedef uint8_t packed_square;
+#define PACKED_SQUARE_BYTES	1
+#define PACK_SQUARE(x, y)	((packed_square) (((x) << 4) | (y)))
+#define UNPACK_SQUARE_X(square)	((int8_t) ((square) >> 4))
+#define UNPACK_SQUARE_Y(square)	((int8_t) ((square) & 0x0F))
+#endif
 
-#define MOVE_BUFFER_SIZE 24
+// Capacity of each player's move queue. Must be a power of two so the ring
+// indices can wrap with a mask.
+#define MOVE_BUFFER_SIZE 32
 #define MOVE_SPEED 100
 
 // Game objects. Note upper 4 bits indicate type, lower 4 bits indicate the
@@ -34,6 +96,14 @@
 #define FINISH_LINE		((uint8_t) 0x20)	// 32
 #define PLAYER_1		((uint8_t) 0x40)	// 64
 #define PLAYER_2		((uint8_t) 0x50)	// 80
+#define PLAYER_3		((uint8_t) 0x60)	// 96
+#define PLAYER_4		((uint8_t) 0x70)	// 112
+
+// Player numbers are consecutive object types, so the state table index is
+// taken straight from the upper 4 bits.
+#define MAX_PLAYERS 4
+#define PLAYER_INDEX(player_num)	(((player_num) >> 4) - (PLAYER_1 >> 4))
+#define PLAYER_NUM(player_index)	((uint8_t) (PLAYER_1 + ((player_index) << 4)))
 
 // Snakes and ladders are represented by a start and end, which must share a
 // common identifier to generate the link. A third type is used to indicate
@@ -48,8 +118,41 @@
 
 #define SNAKE_LADDER_MIDDLE ((uint8_t) 0xF0)	// 240
 
+// Bitboards hold one bit per square for a single kind of object, one uint8_t
+// per row (so WIDTH must be 8). Bit k of row y is the square at path index
+// y * WIDTH + k, which makes consecutive path squares consecutive bits.
+#define BITBOARD_SNAKES		0	// Snake starts
+#define BITBOARD_LADDERS	1	// Ladder starts
+#define BITBOARD_FINISH		2
+#define BITBOARD_PLAYERS	3	// Squares holding at least one player
+#define NUM_BITBOARDS		4
+
+typedef uint8_t bitboard[HEIGHT];
+
 typedef int8_t move_buffer[2];
 
+// Ring buffer of squares still to be animated for a player. head and tail
+// run freely and are masked on access, so tail - head is always the number
+// of queued squares. overflow counts squares dropped while the queue was full.
+// The main loop is the only producer (moves tail) and the animation interrupt
+// the only consumer (moves head). The main loop may only move head with
+// interrupts disabled.
+typedef struct {
+	move_buffer squares[MOVE_BUFFER_SIZE];
+	volatile uint8_t head;
+	volatile uint8_t tail;
+	uint8_t overflow;
+} move_queue;
+
+// Everything tracked for a single player. The player is not stored in the
+// board itself to avoid overwriting game elements when the player is moved.
+typedef struct {
+	int8_t x;
+	int8_t y;
+	uint32_t time_used;	// ms on the clock, excluding any interval still running
+	move_queue moves;
+} player_state;
+
 // Initialise the display of the board. This creates the internal board
 // and also updates the display to show the initialised board.
 void init_game();
@@ -63,6 +166,19 @@ void init_game_board(uint8_t game_board_num);
 // game board.
 uint8_t get_object_at(uint8_t x, uint8_t y);
 
+// Return the object type at (x, y), without its identifier.
+uint8_t get_object_type_at(uint8_t x, uint8_t y);
+
+// Return 1 if the square (x, y) is set in the given bitboard, 0 otherwise.
+uint8_t bitboard_test(uint8_t bitboard_num, int8_t x, int8_t y);
+
+// Return the bits of the given bitboard for the num_squares (at most 8)
+// squares following path index square. Bit 0 is the next square.
+uint8_t bitboard_ahead(uint8_t bitboard_num, square_index square, uint8_t num_squares);
+
+// Return row y of the given bitboard.
+uint8_t bitboard_row(uint8_t bitboard_num, uint8_t y);
+
 // Extract the object type of a game element.
 uint8_t get_object_type(uint8_t object);
 
@@ -78,12 +194,21 @@ uint8_t move_player(int8_t dx, int8_t dy, uint8_t player_num, uint8_t sound_flag
 
 void move_player_constrain(int8_t *player_x, int8_t *player_y);
 
+// Undo the most recent move, returning the player to where it started and
+// giving them the turn again. Returns 1 if a move was undone, 0 if there is no
+// move history left.
+uint8_t undo_move(void);
+
 void move_buffer_reset(void);
 
 void move_buffer_add(int8_t player_x, int8_t player_y, uint8_t player_num);
 
 void move_buffer_remove(uint8_t player_num);
 
+void get_move_buffer(int8_t *player_x, int8_t *player_y, uint8_t player_num);
+
+uint8_t get_move_buffer_overflow(uint8_t player_num);
+
 void move_anim(void);
 
 uint8_t get_move_anim_playing(uint8_t player_num);
@@ -106,6 +231,7 @@ void set_player_visibility(uint8_t visible, uint8_t player_num);
 uint8_t handle_player_collision(int8_t player_x, int8_t player_y, uint8_t player_num);
 
 // Returns the pointers to the coordinates (end_x, end_y) corresponding to the end of an object collision.
+// (end_x, end_y) must hold the position of the object on entry.
 uint8_t collision_object_coords(uint8_t object, int8_t* end_x, int8_t* end_y);
 
 void get_player_n_position(uint8_t player_num, int8_t* player_x, int8_t* player_y);
@@ -116,17 +242,57 @@ uint8_t handle_player_num_change(uint8_t player_num);
 
 uint8_t handle_game_board_num_change();
 
+// Select a board built from a seed by generate_level().
+uint8_t set_generated_board(uint16_t seed, uint8_t num_snakes, uint8_t num_ladders);
+
+uint16_t get_generated_seed(void);
+
+uint8_t get_game_board_number(void);
+
 void set_game_difficulty(uint8_t game_difficulty_num);
 
-uint8_t get_object_at_cursor(int8_t player_x, int8_t player_y, uint8_t player_num);
+// Scroll the viewport of a tall board a row towards the player being watched,
+// one still animating its move or else the player whose turn it is. Called
+// at a regular interval from the main loop.
+void follow_players(void);
 
 uint8_t get_game_difficulty(void);
 
+// Return the time a player has used in 10 ms units. The time is derived from
+// the hardware clock, so it is exact however often this is called. Raises the
+// game over event when the player reaches the time limit.
 uint16_t update_player_time(uint8_t player_num);
 
+// Stop (1) or restart (0) the running player timer while the game is paused.
+void pause_player_timer(uint8_t pause_flag);
+
 uint8_t get_single_player(void);
 
-void set_single_player(uint8_t player_flag);
+uint8_t get_num_players(void);
+
+// Set the number of players taking part (1 to MAX_PLAYERS).
+void set_num_players(uint8_t player_count);
+
+// Return the player whose turn it is.
+uint8_t get_active_player(void);
+
+// Pass the turn to the next player and return them.
+uint8_t next_active_player(void);
+
+// Bytes stored by pack_game_state() before the players and for each player,
+// and the largest number of bytes written.
+#define GAME_STATE_PLAYER_SIZE (sizeof(square_index) + 2)
+#define GAME_STATE_HEADER_SIZE 9
+#define GAME_STATE_MAX_SIZE (GAME_STATE_HEADER_SIZE + GAME_STATE_PLAYER_SIZE * MAX_PLAYERS)
+
+// Write the game state (board, difficulty, players, turns and result) into
+// buffer. Returns the number of bytes written.
+uint8_t pack_game_state(uint8_t* buffer);
+
+// Restore the game state written by pack_game_state(), reloading the board
+// and redrawing the players. Returns the number of bytes read, or 0 if the
+// data is not valid (in which case nothing is changed).
+uint8_t unpack_game_state(const uint8_t* buffer, uint8_t length);
 
 // Returns 1 if the game is over, 0 otherwise.
 uint8_t is_game_over(void);
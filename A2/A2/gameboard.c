@@ -5,79 +5,363 @@
  *  Author: LiamM
  */ 
 
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
+#include <avr/pgmspace.h>
+#include <avr/eeprom.h>
+#include <util/crc16.h>
 #include "gameboard.h"
-#include "display.h"
+#include "level_pack.h"
+#include "levelupload.h"
 #include "game.h"
 
-static game_board_layout game_board_1_layout[HEIGHT] = {
-	{FINISH_LINE, 0, 0, 0, 0, 0, 0, 0},
-	{0, SNAKE_START | 4, 0, 0, LADDER_END | 4, 0, 0, 0},
-	{0, SNAKE_MIDDLE, 0, LADDER_MIDDLE, 0, 0, 0, 0},
-	{0, SNAKE_MIDDLE, LADDER_START | 4, 0, 0, 0, 0, 0},
-	{0, SNAKE_END | 4, 0, 0, 0, 0, SNAKE_START | 3, 0},
-	{0, 0, 0, 0, LADDER_END | 3, 0, SNAKE_MIDDLE, 0},
-	{SNAKE_START | 2, 0, 0, 0, LADDER_MIDDLE, 0, SNAKE_MIDDLE, 0},
-	{0, SNAKE_MIDDLE, 0, 0, LADDER_START | 3, 0, SNAKE_END | 3, 0},
-	{0, 0, SNAKE_END | 2, 0, 0, 0, 0, 0},
-	{0, 0, 0, 0, 0, 0, 0, 0},
-	{0, 0, 0, 0, 0, 0, 0, 0},
-	{0, 0, 0, SNAKE_START | 1, 0, 0, 0, LADDER_END | 1},
-	{0, LADDER_END | 2, 0, SNAKE_MIDDLE, 0, 0, LADDER_MIDDLE, 0},
-	{0, LADDER_MIDDLE, 0, SNAKE_MIDDLE, 0, LADDER_START | 1, 0, 0},
-	{0, LADDER_START | 2, 0, SNAKE_MIDDLE, 0, 0, 0, 0},
-	{START_POINT, 0, 0, SNAKE_END | 1, 0, 0, 0, 0}
-};
-
-static game_board_layout game_board_2_layout[HEIGHT] = {
-	{FINISH_LINE, 0, SNAKE_START | 4, 0, LADDER_END | 4, 0, 0, 0},
-	{0, 0, SNAKE_MIDDLE, 0, 0, LADDER_MIDDLE, 0, 0},
-	{0, 0, SNAKE_END | 4, 0, 0, 0, LADDER_START | 4, SNAKE_START | 3},
-	{0, 0, 0, 0, 0, 0, SNAKE_MIDDLE, 0},
-	{LADDER_END | 3, 0, 0, LADDER_END | 2, 0, SNAKE_MIDDLE, 0, 0},
-	{LADDER_MIDDLE, 0, 0, 0, SNAKE_LADDER_MIDDLE, 0, 0, 0},
-	{LADDER_MIDDLE, 0, 0, SNAKE_MIDDLE, 0, LADDER_MIDDLE, 0, 0},
-	{LADDER_MIDDLE, 0, SNAKE_END | 3, 0, 0, 0, LADDER_MIDDLE, 0},
-	{LADDER_MIDDLE, 0, 0, 0, 0, 0, SNAKE_START | 2, LADDER_START | 2},
-	{LADDER_START | 3, 0, 0, 0, 0, 0, SNAKE_MIDDLE, 0},
-	{0, 0, 0, 0, 0, 0, SNAKE_MIDDLE, 0},
-	{0, SNAKE_START | 1, 0, LADDER_END | 1, 0, 0, SNAKE_MIDDLE, 0},
-	{0, 0, SNAKE_MIDDLE, LADDER_MIDDLE, 0, 0, SNAKE_END | 2, 0},
-	{0, 0, 0, SNAKE_LADDER_MIDDLE, 0, 0, 0, 0},
-	{0, 0, 0, LADDER_MIDDLE, SNAKE_MIDDLE, 0, 0, 0},
-	{START_POINT, 0, 0, LADDER_START | 1, 0, SNAKE_END | 1, 0, 0}
-};
-
-static game_board game_board_formatted[WIDTH];
-
-// Select a game board layout from a board number.
-game_board_layout* get_game_starting_layout(uint8_t game_board_num)  {
-	switch (game_board_num) {
-		case GAMEBOARD_1:
-			return game_board_1_layout;
-			break;
-		case GAMEBOARD_2:
-			return game_board_2_layout;
-			break;
-		default:
-			return game_board_1_layout;
-			break;
-	}
+// The level pack and its index are generated from levels/*.txt by
+// tools/levelc.c, which also checks every level and works out the link
+// destinations and body paths, so levels are loaded without any searching.
+#define NUM_LEVELS	LEVEL_PACK_COUNT
+
+#if LEVEL_PACK_HEIGHT != HEIGHT
+#error "level_pack.h was built for a different BOARD_HEIGHT, rebuild it with levelc"
+#endif
+
+// Offsets in a packed level: the number of links, the first link, and the
+// parts of each link before its body.
+#define LEVEL_NUM_LINKS		LEVEL_CELL_BYTES
+#define LEVEL_LINKS			(LEVEL_CELL_BYTES + 1)
+#define LINK_END			PACKED_SQUARE_BYTES
+#define LINK_DESTINATION	(2 * PACKED_SQUARE_BYTES)
+#define LINK_BODY_LENGTH	(3 * PACKED_SQUARE_BYTES)
+#define LINK_BODY			(3 * PACKED_SQUARE_BYTES + 1)
+
+#if LINK_BODY * (MAX_LEVEL_LINKS - 1) + PACKED_SQUARE_BYTES * LEVEL_BODY_POOL_SIZE > 255
+#error "level_data link_offsets are too small for the largest level"
+#endif
+
+// Return the number of levels in the level pack. Levels are numbered from 1.
+uint8_t get_num_levels(void) {
+	return NUM_LEVELS;
+}
+
+// Return the number of boards that can be selected: the level pack followed
+// by the upload slots (some of which may be empty).
+uint8_t get_num_boards(void) {
+	return NUM_LEVELS + UPLOAD_SLOTS;
+}
+
+// Return the fewest dice rolls needed to finish a level, or 0 if there is
+// no level with the given number (or it was uploaded).
+uint8_t get_level_min_rolls(uint8_t level_num) {
+	if (level_num < 1 || level_num > NUM_LEVELS) return 0;
+	
+	return pgm_read_byte(&level_min_rolls[level_num - 1]);
+}
+
+// Byte readers for the memories a packed level can be in.
+static uint8_t read_ram_byte(const uint8_t* address) {
+	return *address;
+}
+
+static uint8_t read_flash_byte(const uint8_t* address) {
+	return pgm_read_byte(address);
+}
+
+// Read a square (little endian if it takes two bytes) and advance packed
+// past it.
+static packed_square read_square(uint8_t (*read_byte)(const uint8_t*), const uint8_t** packed) {
+	packed_square square = read_byte((*packed)++);
+	
+#if PACKED_SQUARE_BYTES == 2
+	square |= (packed_square) read_byte((*packed)++) << 8;
+#endif
+	return square;
 }
 
-// Return pointer to 2D array that represents the game board.
-game_board* get_game_board(game_board_layout* starting_layout) {
-	// Initialise the state of the playing_field
-	for (int x = 0; x < WIDTH; x++) {
-		for (int y = 0; y < HEIGHT; y++) {
-			// Initialise this square based on the starting layout
-			// the indices here are to ensure the starting layout
-			// could be easily visualised when declared
-			game_board_formatted[x][y] = starting_layout[HEIGHT - 1 - y][x];
-			uint8_t board_object_type = get_object_type(starting_layout[HEIGHT - 1 - y][x]);
-			update_square_colour(x, y, board_object_type);
+// Return 1 if a packed square is on the board.
+static uint8_t square_on_board(packed_square square) {
+	return UNPACK_SQUARE_X(square) < WIDTH && UNPACK_SQUARE_Y(square) < HEIGHT;
+}
+
+// Check a packed level of the given length, read with read_byte. Returns 0
+// if the level is not valid. Levels in the level pack have already been
+// checked by levelc, but uploaded ones come from outside.
+static uint8_t check_level(uint8_t (*read_byte)(const uint8_t*), const uint8_t* packed, uint16_t length) {
+	const uint8_t* end = packed + length;
+	uint8_t body_used = 0;
+	
+	if (length < LEVEL_LINKS) return 0;
+	
+	packed += LEVEL_NUM_LINKS;
+	uint8_t num_links = read_byte(packed++);
+	
+	if (num_links > MAX_LEVEL_LINKS) return 0;
+	
+	for (uint8_t i = 0; i < num_links; i++) {
+		if (end - packed < LINK_BODY) return 0;
+		for (uint8_t j = 0; j < 3; j++) {
+			if (!square_on_board(read_square(read_byte, &packed))) return 0;
 		}
+		
+		uint8_t body_length = read_byte(packed++);
+		
+		if (body_length > MAX_LEVEL_BODY || body_used + body_length > LEVEL_BODY_POOL_SIZE) return 0;
+		if (end - packed < body_length * PACKED_SQUARE_BYTES) return 0;
+		
+		for (uint8_t j = 0; j < body_length; j++) {
+			if (!square_on_board(read_square(read_byte, &packed))) return 0;
+		}
+		body_used += body_length;
+	}
+	
+	return packed == end;
+}
+
+// Return 1 if a packed level in RAM is valid.
+uint8_t check_level_image(const uint8_t* image, uint16_t length) {
+	return check_level(read_ram_byte, image, length);
+}
+
+// Find the packed form of a board: the level pack for level numbers, an upload
+// slot for numbers after the level pack. Returns its length, or 0 if there is
+// no board with the given number.
+static uint16_t find_level(uint8_t level_num, uint8_t (**read_byte)(const uint8_t*), const uint8_t** packed) {
+	if (level_num < 1 || level_num > get_num_boards()) return 0;
+	
+	if (level_num > NUM_LEVELS) {
+		uint8_t slot = level_num - NUM_LEVELS - 1;
+		
+		*read_byte = eeprom_read_byte;
+		*packed = upload_slot_image(slot);
+		return upload_slot_length(slot);
+	}
+	
+	uint16_t offset = pgm_read_word(&level_index[level_num - 1]);
+	
+	*read_byte = read_flash_byte;
+	*packed = level_pack + offset;
+	return (level_num < NUM_LEVELS) ? pgm_read_word(&level_index[level_num]) - offset : sizeof(level_pack) - offset;
+}
+
+// Read the byte at offset in a level.
+static uint8_t level_byte(const level_data* level, uint16_t offset) {
+	if (level->in_flash) {
+		return pgm_read_byte(level->packed + offset);
+	}
+	return level->packed[offset];
+}
+
+// Read the square at offset in a level.
+static packed_square level_square(const level_data* level, uint16_t offset) {
+	packed_square square = level_byte(level, offset);
+	
+#if PACKED_SQUARE_BYTES == 2
+	square |= (packed_square) level_byte(level, offset + 1) << 8;
+#endif
+	return square;
+}
+
+// Return the offset of the given part of a link in a level.
+static uint16_t link_part(const level_data* level, uint8_t identifier, uint8_t part) {
+	return LEVEL_LINKS + level->link_offsets[identifier - 1] + part;
+}
+
+// Note where each link of a level is, and its length.
+static void index_links(level_data* level) {
+	uint16_t offset = 0;
+	
+	level->num_links = level_byte(level, LEVEL_NUM_LINKS);
+	for (uint8_t i = 0; i < level->num_links; i++) {
+		level->link_offsets[i] = offset;
+		offset += LINK_BODY + level_byte(level, LEVEL_LINKS + offset + LINK_BODY_LENGTH) * PACKED_SQUARE_BYTES;
+	}
+	level->length = LEVEL_LINKS + offset;
+}
+
+// Open a level from the level pack, or from an upload slot for numbers after
+// the level pack, into level. Levels in the level pack are read in place,
+// uploaded ones are copied into the upload buffer. Returns 0 if there is no
+// level with the given number. level may be NULL to just check that the
+// level is there.
+uint8_t load_level(uint8_t level_num, level_data* level) {
+	uint8_t (*read_byte)(const uint8_t*);
+	const uint8_t* packed;
+	uint8_t* image = NULL;
+	
+	// Claiming the buffer finishes writing any level just uploaded, which
+	// may be going into this slot, so it comes first.
+	if (level && level_num > NUM_LEVELS) {
+		image = upload_claim_buffer();
 	}
 	
-	return game_board_formatted;
-}
\ No newline at end of file
+	uint16_t length = find_level(level_num, &read_byte, &packed);
+	
+	if (length == 0 || !check_level(read_byte, packed, length)) return 0;
+	if (level == NULL) return 1;
+	
+	if (image) {
+		eeprom_read_block(image, packed, length);
+		level->packed = image;
+		level->in_flash = 0;
+	}
+	else {
+		upload_release_buffer();
+		level->packed = packed;
+		level->in_flash = 1;
+	}
+	index_links(level);
+	
+	return 1;
+}
+
+// Return a CRC-8 of the packed form of a board, so a saved game can tell
+// whether the board it was played on has since been replaced (e.g. by an
+// upload into its slot). Returns 0 if there is no board with the number.
+uint8_t level_checksum(uint8_t level_num) {
+	uint8_t (*read_byte)(const uint8_t*);
+	const uint8_t* packed;
+	uint16_t length = find_level(level_num, &read_byte, &packed);
+	uint8_t crc = 0;
+	
+	while (length-- > 0) {
+		crc = _crc8_ccitt_update(crc, read_byte(packed++));
+	}
+	return crc;
+}
+
+// Return the object type of the cell at (x,y) of a level, without its
+// identifier. This is a single read, for drawing the board.
+uint8_t level_type_at(const level_data* level, uint8_t x, uint8_t y) {
+	square_index index = x * HEIGHT + y;
+	uint8_t cells = level_byte(level, index >> 1);
+	
+	return (index & 1) ? (uint8_t) (cells << 4) : (cells & 0xF0);
+}
+
+// Return the game object at (x,y) of a level. The identifier of a snake or
+// ladder start or end is found by checking the starts or ends of the links.
+uint8_t level_object_at(const level_data* level, uint8_t x, uint8_t y) {
+	uint8_t type = level_type_at(level, x, y);
+	uint8_t part;
+	
+	if (type == SNAKE_START || type == LADDER_START) {
+		part = 0;
+	}
+	else if (type == SNAKE_END || type == LADDER_END) {
+		part = LINK_END;
+	}
+	else {
+		return type;
+	}
+	
+	for (uint8_t i = 1; i <= level->num_links; i++) {
+		if (level_square(level, link_part(level, i, part)) == PACK_SQUARE(x, y)) return type | i;
+	}
+	return type;
+}
+
+// Read the link with the given identifier into link. Returns 0 if there is
+// no such link.
+uint8_t level_get_link(const level_data* level, uint8_t identifier, level_link* link) {
+	if (identifier < 1 || identifier > level->num_links) return 0;
+	
+	link->start = level_square(level, link_part(level, identifier, 0));
+	link->end = level_square(level, link_part(level, identifier, LINK_END));
+	link->destination = level_square(level, link_part(level, identifier, LINK_DESTINATION));
+	link->body_length = level_byte(level, link_part(level, identifier, LINK_BODY_LENGTH));
+	return 1;
+}
+
+// Return body square i (from the start) of the link with the given identifier.
+packed_square level_body_square(const level_data* level, uint8_t identifier, uint8_t i) {
+	return level_square(level, link_part(level, identifier, LINK_BODY + i * PACKED_SQUARE_BYTES));
+}
+
+// Return the number of body squares used by all links of a level.
+uint8_t level_body_used(const level_data* level) {
+	return (level->length - LEVEL_LINKS - level->num_links * LINK_BODY) / PACKED_SQUARE_BYTES;
+}
+
+// The bytes of a level held in the upload buffer, for changing them.
+static uint8_t* level_bytes(level_data* level) {
+	return (uint8_t*) level->packed;
+}
+
+// Write a square at offset in a level held in the upload buffer.
+static void set_level_square(level_data* level, uint16_t offset, packed_square square) {
+	uint8_t* packed = level_bytes(level) + offset;
+	
+	packed[0] = square & 0xFF;
+#if PACKED_SQUARE_BYTES == 2
+	packed[1] = square >> 8;
+#endif
+}
+
+// Start an empty level (no objects and no links) in the upload buffer.
+void level_new(level_data* level) {
+	level->packed = upload_claim_buffer();
+	level->in_flash = 0;
+	memset(level_bytes(level), 0, LEVEL_LINKS);
+	index_links(level);
+}
+
+// Copy a level from the level pack into the upload buffer so it can be
+// changed. A level already there is left as it is.
+void level_make_editable(level_data* level) {
+	if (!level->in_flash) return;
+	
+	uint8_t* packed = upload_claim_buffer();
+	
+	memcpy_P(packed, level->packed, level->length);
+	level->packed = packed;
+	level->in_flash = 0;
+}
+
+// Set the object type of the cell at (x,y) of a level.
+void level_set_cell(level_data* level, uint8_t x, uint8_t y, uint8_t type) {
+	square_index index = x * HEIGHT + y;
+	uint8_t* cells = &level_bytes(level)[index >> 1];
+	
+	if (index & 1) {
+		*cells = (*cells & 0xF0) | (type >> 4);
+	}
+	else {
+		*cells = (*cells & 0x0F) | type;
+	}
+}
+
+// Add a link from start to end, with no body, after the other links of a
+// level. Its destination is its end.
+void level_add_link(level_data* level, packed_square start, packed_square end) {
+	uint16_t offset = level->length;
+	
+	set_level_square(level, offset, start);
+	set_level_square(level, offset + LINK_END, end);
+	set_level_square(level, offset + LINK_DESTINATION, end);
+	level_bytes(level)[offset + LINK_BODY_LENGTH] = 0;
+	level_bytes(level)[LEVEL_NUM_LINKS]++;
+	index_links(level);
+}
+
+// Add a square to the end of the body of the last link of a level.
+void level_add_body_square(level_data* level, packed_square square) {
+	set_level_square(level, level->length, square);
+	level_bytes(level)[link_part(level, level->num_links, LINK_BODY_LENGTH)]++;
+	level->length += PACKED_SQUARE_BYTES;
+}
+
+// Set where the link with the given identifier finally leads.
+void level_set_destination(level_data* level, uint8_t identifier, packed_square destination) {
+	set_level_square(level, link_part(level, identifier, LINK_DESTINATION), destination);
+}
+
+// Remove the link with the given identifier from a level. Identifiers come
+// from the link order, so the links after it are renumbered. Its cells are
+// left as they are.
+void level_remove_link(level_data* level, uint8_t identifier) {
+	uint16_t offset = link_part(level, identifier, 0);
+	uint16_t next = offset + LINK_BODY + level_byte(level, offset + LINK_BODY_LENGTH) * PACKED_SQUARE_BYTES;
+	
+	memmove(level_bytes(level) + offset, level_bytes(level) + next, level->length - next);
+	level_bytes(level)[LEVEL_NUM_LINKS]--;
+	index_links(level);
+}
@@ -9,17 +9,94 @@
 #ifndef GAMEBOARD_H_
 #define GAMEBOARD_H_
 
+#define GAMEBOARD_GENERATED 0	// Built by generate_level() from a seed
 #define GAMEBOARD_1 1
 #define GAMEBOARD_2 2
 
 #include <stdint.h>
 #include "game.h"
 
-typedef uint8_t game_board_layout[WIDTH];
-typedef uint8_t game_board[HEIGHT];
+// Levels are stored with a 4 bit object type per cell, two cells to a byte
+// (the cell with the even index in the upper nibble). Cells are indexed
+// x * HEIGHT + y, with (0,0) the bottom left square. The cells are followed
+// by the number of links and then, for each snake or ladder:
+//   start square, end square, destination square, body length,
+//   body squares (from the start towards the end, both excluded)
+// with squares packed as with PACK_SQUARE() (PACKED_SQUARE_BYTES each, little
+// endian). The destination is the final
+// square reached once any chained jumps from the end have been followed.
+// Whether a link is a snake or a ladder comes from the type of its start
+// cell. The level pack is generated and checked by tools/levelc.c.
+#define LEVEL_CELL_BYTES	(BOARD_SQUARES / 2)
+#define MAX_LEVEL_LINKS		15	// Identifiers run from 1 to 15
+#define MAX_LEVEL_BODY		16	// Body squares of a single link
+#define LEVEL_BODY_POOL_SIZE	64	// Body squares of all links in a level
 
-game_board_layout* get_game_starting_layout(uint8_t game_board_num);
+// Largest packed level: every link with the longest body the pool allows
+#define LEVEL_MAX_BYTES		(LEVEL_CELL_BYTES + 1 + (3 * PACKED_SQUARE_BYTES + 1) * MAX_LEVEL_LINKS \
+		+ PACKED_SQUARE_BYTES * LEVEL_BODY_POOL_SIZE)
 
-game_board* get_game_board(game_board_layout* starting_layout);
+// A snake or ladder, as read from a level by level_get_link().
+typedef struct {
+	packed_square start;
+	packed_square end;
+	packed_square destination;
+	uint8_t body_length;	// 0 if the jump should be drawn in a straight line
+} level_link;
+
+// A level as played or edited, left in the packed format above. Levels from
+// the level pack are read in place from flash and take no RAM. Any other
+// board (generated, copied out of an upload slot, or being edited) is held in
+// the upload buffer, see upload_claim_buffer(). Snake and ladder starts and
+// ends get the number of their link (from 1) as their identifier, and
+// link_offsets locates each link so it is read without walking the level.
+typedef struct {
+	const uint8_t* packed;	// In flash if in_flash is set, else in RAM
+	uint8_t in_flash;
+	uint8_t num_links;
+	uint16_t length;
+	uint8_t link_offsets[MAX_LEVEL_LINKS];	// From the first link
+} level_data;
+
+uint8_t get_num_levels(void);
+
+uint8_t get_num_boards(void);
+
+uint8_t get_level_min_rolls(uint8_t level_num);
+
+uint8_t check_level_image(const uint8_t* image, uint16_t length);
+
+uint8_t load_level(uint8_t level_num, level_data* level);
+
+uint8_t level_checksum(uint8_t level_num);
+
+uint8_t level_type_at(const level_data* level, uint8_t x, uint8_t y);
+
+uint8_t level_object_at(const level_data* level, uint8_t x, uint8_t y);
+
+uint8_t level_get_link(const level_data* level, uint8_t identifier, level_link* link);
+
+packed_square level_body_square(const level_data* level, uint8_t identifier, uint8_t i);
+
+uint8_t level_body_used(const level_data* level);
+
+// Changing a level. level_new() and level_make_editable() claim the upload
+// buffer, the others only work on a level held in it.
+void level_new(level_data* level);
+
+void level_make_editable(level_data* level);
+
+void level_set_cell(level_data* level, uint8_t x, uint8_t y, uint8_t type);
+
+void level_add_link(level_data* level, packed_square start, packed_square end);
+
+void level_add_body_square(level_data* level, packed_square square);
+
+void level_set_destination(level_data* level, uint8_t identifier, packed_square destination);
+
+void level_remove_link(level_data* level, uint8_t identifier);
+
+// The board being played, in game.c. The editor changes it in place.
+level_data* get_game_board(void);
 
 #endif /* GAMEBOARD_H_ */
\ No newline at end of file
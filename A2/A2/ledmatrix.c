@@ -7,7 +7,9 @@
  */ 
 
 #include "ledmatrix.h"
+#include <stdlib.h>
 #include <avr/io.h>
+#include <util/atomic.h>
 #include "spi.h"
 
 #define CMD_UPDATE_ALL		0x00
@@ -17,18 +19,270 @@
 #define CMD_SHIFT_DISPLAY	0x04
 #define CMD_CLEAR_SCREEN	0x0F
 
+// Drawing only changes a shadow copy of the matrix in RAM, marking the cells
+// that changed colour in a dirty bitmap (bit x of dirty[y]). ledmatrix_flush()
+// sends the dirty cells through the SPI transmit queue (see spi.h), with
+// whichever mix of pixel, row, column and whole matrix commands takes the
+// fewest bytes, so a cell drawn several times between flushes, or drawn in
+// the colour it already has, costs nothing on the wire. Clears and shifts change the shadow straight away
+// and are sent at the next flush, ahead of the cells. The animations draw from
+// the timer interrupt, so the shadow is changed with interrupts off. Only the
+// main loop flushes, which keeps it the only producer for the SPI queue.
+static MatrixData shadow;
+static volatile uint16_t dirty[MATRIX_NUM_ROWS];
+static volatile uint8_t clear_pending;
+static volatile int8_t shift_pending_x;	// Net shifts right (left if negative)
+static volatile int8_t shift_pending_y;	// Net shifts up (down if negative)
+
+// Send a command of up to three bytes
+static void send_command(uint8_t command, uint8_t arg1, uint8_t arg2, uint8_t length) {
+	spi_queue_byte(command);
+	if (length > 1) spi_queue_byte(arg1);
+	if (length > 2) spi_queue_byte(arg2);
+}
+
 void ledmatrix_setup(void) {
 	// Setup SPI - we divide the clock by 128.
 	// (This speed guarantees the SPI buffer will never overflow on
 	// the LED matrix.)
 	spi_setup_master(128);
+	
+	// The shadow starts cleared, so clear the matrix to match.
+	ledmatrix_clear();
+}
+
+// Set a cell of the shadow, marking it dirty if it changed. Interrupts must be
+// off.
+static void set_cell(uint8_t x, uint8_t y, PixelColour pixel) {
+	if (shadow[x][y] != pixel) {
+		shadow[x][y] = pixel;
+		dirty[y] |= (uint16_t) 1 << x;
+	}
+}
+
+// Bytes taken by each command
+#define PIXEL_LENGTH	3
+#define ROW_LENGTH		(2 + MATRIX_NUM_COLUMNS)
+#define COLUMN_LENGTH	(2 + MATRIX_NUM_ROWS)
+#define ALL_LENGTH		(1 + MATRIX_NUM_ROWS * MATRIX_NUM_COLUMNS)
+
+// Return the number of bits set
+static uint8_t count_bits(uint16_t bits) {
+	uint8_t count = 0;
+	
+	for (; bits; bits &= bits - 1) {
+		count++;
+	}
+	return count;
+}
+
+// Plan the commands for the dirty cells d. The lines one way (rows if
+// rows_first, else columns) with enough dirty cells to be cheaper sent whole
+// are picked first. Then each line the other way is sent whole or as pixels,
+// whichever is cheaper, for the cells left. The lines to send whole are
+// returned in row_mask and column_mask (the rest go as pixels) and the
+// bytes needed are returned.
+static uint16_t plan_lines(const uint16_t* d, uint8_t rows_first, uint8_t* row_mask, uint16_t* column_mask) {
+	uint16_t length = 0;
+	
+	*row_mask = 0;
+	*column_mask = 0;
+	
+	if (rows_first) {
+		for (uint8_t y = 0; y < MATRIX_NUM_ROWS; y++) {
+			if (count_bits(d[y]) * PIXEL_LENGTH > ROW_LENGTH) {
+				*row_mask |= 1 << y;
+				length += ROW_LENGTH;
+			}
+		}
+	}
+	for (uint8_t x = 0; x < MATRIX_NUM_COLUMNS; x++) {
+		uint8_t count = 0;
+		
+		for (uint8_t y = 0; y < MATRIX_NUM_ROWS; y++) {
+			if (!(*row_mask & (1 << y)) && (d[y] & ((uint16_t) 1 << x))) {
+				count++;
+			}
+		}
+		if (count * PIXEL_LENGTH > COLUMN_LENGTH) {
+			*column_mask |= (uint16_t) 1 << x;
+			length += COLUMN_LENGTH;
+		}
+		else if (rows_first) {
+			length += count * PIXEL_LENGTH;
+		}
+	}
+	if (!rows_first) {
+		for (uint8_t y = 0; y < MATRIX_NUM_ROWS; y++) {
+			uint8_t count = count_bits(d[y] & ~*column_mask);
+			
+			if (count * PIXEL_LENGTH > ROW_LENGTH) {
+				*row_mask |= 1 << y;
+				length += ROW_LENGTH;
+			}
+			else {
+				length += count * PIXEL_LENGTH;
+			}
+		}
+	}
+	return length;
+}
+
+// Send a row (y), column (x) or pixel (x, y) command with the cells of the
+// shadow, marking them clean. Returns 0 without sending anything if the SPI
+// queue is too full, or if a clear or shift drawn since the flush began has
+// to be sent first. Interrupts are kept off while the cells are queued so
+// none change unseen.
+static uint8_t send_cells(uint8_t command, uint8_t x, uint8_t y) {
+	uint8_t length = (command == CMD_UPDATE_ROW) ? ROW_LENGTH :
+			(command == CMD_UPDATE_COL) ? COLUMN_LENGTH : PIXEL_LENGTH;
+	
+	if (spi_queue_free() < length) {
+		return 0;
+	}
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		if (clear_pending || shift_pending_x || shift_pending_y) {
+			return 0;
+		}
+		spi_queue_byte(command);
+		if (command == CMD_UPDATE_ROW) {
+			spi_queue_byte(y & 0x07);
+			for (x = 0; x < MATRIX_NUM_COLUMNS; x++) {
+				spi_queue_byte(shadow[x][y]);
+			}
+			dirty[y] = 0;
+		}
+		else if (command == CMD_UPDATE_COL) {
+			spi_queue_byte(x & 0x0F);
+			for (y = 0; y < MATRIX_NUM_ROWS; y++) {
+				spi_queue_byte(shadow[x][y]);
+				dirty[y] &= ~((uint16_t) 1 << x);
+			}
+		}
+		else {
+			spi_queue_byte(((y & 0x07) << 4) | (x & 0x0F));
+			spi_queue_byte(shadow[x][y]);
+			dirty[y] &= ~((uint16_t) 1 << x);
+		}
+	}
+	return 1;
+}
+
+// Send the whole shadow in one command, in place of any clear or shifts still
+// to be sent. The SPI queue must be empty: the first byte goes straight out,
+// so the rest fit in the queue (at worst waiting for the byte before it).
+static void send_all(void) {
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		clear_pending = 0;
+		shift_pending_x = 0;
+		shift_pending_y = 0;
+		
+		spi_queue_byte(CMD_UPDATE_ALL);
+		for (uint8_t y = 0; y < MATRIX_NUM_ROWS; y++) {
+			for (uint8_t x = 0; x < MATRIX_NUM_COLUMNS; x++) {
+				spi_queue_byte(shadow[x][y]);
+			}
+			dirty[y] = 0;
+		}
+	}
+}
+
+void ledmatrix_flush(void) {
+	uint16_t d[MATRIX_NUM_ROWS];
+	uint16_t any_dirty = 0;
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		for (uint8_t y = 0; y < MATRIX_NUM_ROWS; y++) {
+			d[y] = dirty[y];
+			any_dirty |= d[y];
+		}
+	}
+	if (!any_dirty && !clear_pending && !shift_pending_x && !shift_pending_y) {
+		return;
+	}
+	
+	// Plan the cheapest mix of rows, columns and pixels for the dirty cells,
+	// and send everything at once instead if that takes fewer bytes (e.g.
+	// when a new screen has been drawn)
+	uint8_t row_mask, other_row_mask;
+	uint16_t column_mask, other_column_mask;
+	uint16_t length = plan_lines(d, 1, &row_mask, &column_mask);
+	uint16_t other_length = plan_lines(d, 0, &other_row_mask, &other_column_mask);
+	
+	if (other_length < length) {
+		length = other_length;
+		row_mask = other_row_mask;
+		column_mask = other_column_mask;
+	}
+	length += clear_pending + 2 * (abs(shift_pending_x) + abs(shift_pending_y));
+	
+	if (length > ALL_LENGTH) {
+		// Wait for the queue to empty, which it does within a few ms
+		if (spi_queue_free() == SPI_QUEUE_SIZE) {
+			send_all();
+		}
+		return;
+	}
+	
+	// Clear and shift first, so the cells sent after them land where the
+	// shadow has them. Only as much as fits in the SPI queue is sent, the
+	// rest is left for the next flush so the main loop never waits.
+	if (clear_pending) {
+		if (spi_queue_free() < 1) return;
+		
+		clear_pending = 0;
+		send_command(CMD_CLEAR_SCREEN, 0, 0, 1);
+	}
+	while (shift_pending_x || shift_pending_y) {
+		uint8_t direction;
+		
+		if (spi_queue_free() < 2) return;
+		
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+			if (shift_pending_x > 0) {
+				shift_pending_x--;
+				direction = 0x01;
+			}
+			else if (shift_pending_x < 0) {
+				shift_pending_x++;
+				direction = 0x02;
+			}
+			else if (shift_pending_y > 0) {
+				shift_pending_y--;
+				direction = 0x08;
+			}
+			else {
+				shift_pending_y++;
+				direction = 0x04;
+			}
+		}
+		send_command(CMD_SHIFT_DISPLAY, direction, 0, 2);
+	}
+	
+	for (uint8_t y = 0; y < MATRIX_NUM_ROWS; y++) {
+		if ((row_mask & (1 << y)) && !send_cells(CMD_UPDATE_ROW, 0, y)) return;
+	}
+	for (uint8_t x = 0; x < MATRIX_NUM_COLUMNS; x++) {
+		if ((column_mask & ((uint16_t) 1 << x)) && !send_cells(CMD_UPDATE_COL, x, 0)) return;
+	}
+	for (uint8_t y = 0; y < MATRIX_NUM_ROWS; y++) {
+		if (row_mask & (1 << y)) continue;
+		
+		uint16_t bits = d[y] & ~column_mask;
+		
+		for (uint8_t x = 0; bits; x++, bits >>= 1) {
+			if ((bits & 1) && !send_cells(CMD_UPDATE_PIXEL, x, y)) return;
+		}
+	}
 }
 
 void ledmatrix_update_all(MatrixData data) {
-	(void)spi_send_byte(CMD_UPDATE_ALL);
-	for(uint8_t y=0; y<MATRIX_NUM_ROWS; y++) {
-		for(uint8_t x=0; x<MATRIX_NUM_COLUMNS; x++) {
-			(void)spi_send_byte(data[x][y]);
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		for (uint8_t x = 0; x < MATRIX_NUM_COLUMNS; x++) {
+			for (uint8_t y = 0; y < MATRIX_NUM_ROWS; y++) {
+				set_cell(x, y, data[x][y]);
+			}
 		}
 	}
 }
@@ -38,9 +292,9 @@ void ledmatrix_update_pixel(uint8_t x, uint8_t y, PixelColour pixel) {
 		// Position isn't valid - we ignore the request.
 		return;
 	}
-	(void)spi_send_byte(CMD_UPDATE_PIXEL);
-	(void)spi_send_byte(((y & 0x07) << 4) | (x & 0x0F));
-	(void)spi_send_byte(pixel);
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		set_cell(x, y, pixel);
+	}
 }
 
 void ledmatrix_update_row(uint8_t y, MatrixRow row) {
@@ -48,10 +302,10 @@ void ledmatrix_update_row(uint8_t y, MatrixRow row) {
 		// y value is too large - we ignore the request
 		return;
 	}
-	(void)spi_send_byte(CMD_UPDATE_ROW);
-	(void)spi_send_byte(y & 0x07);	// row number
-	for(uint8_t x = 0; x<MATRIX_NUM_COLUMNS; x++) {
-		(void)spi_send_byte(row[x]);
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		for(uint8_t x = 0; x<MATRIX_NUM_COLUMNS; x++) {
+			set_cell(x, y, row[x]);
+		}
 	}
 }
 
@@ -60,35 +314,87 @@ void ledmatrix_update_column(uint8_t x, MatrixColumn col) {
 		// x value is too large - we ignore the request
 		return;
 	}
-	(void)spi_send_byte(CMD_UPDATE_COL);
-	(void)spi_send_byte(x & 0x0F); // column number
-	for(uint8_t y = 0; y<MATRIX_NUM_ROWS; y++) {
-		(void)spi_send_byte(col[y]);
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		for(uint8_t y = 0; y<MATRIX_NUM_ROWS; y++) {
+			set_cell(x, y, col[y]);
+		}
+	}
+}
+
+// Shift the shadow (and its dirty bits) one column left (dx = -1) or right
+// (dx = 1), or one row down (dy = -1) or up (dy = 1). The cells shifted in
+// are blank and marked dirty, so they are sent whatever the matrix itself
+// shifts in.
+static void shift_shadow(int8_t dx, int8_t dy) {
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		if (dx < 0) {
+			for (uint8_t x = 0; x < MATRIX_NUM_COLUMNS - 1; x++) {
+				copy_matrix_column(shadow[x + 1], shadow[x]);
+			}
+			set_matrix_column_to_colour(shadow[MATRIX_NUM_COLUMNS - 1], 0);
+			for (uint8_t y = 0; y < MATRIX_NUM_ROWS; y++) {
+				dirty[y] = (dirty[y] >> 1) | ((uint16_t) 1 << (MATRIX_NUM_COLUMNS - 1));
+			}
+		}
+		else if (dx > 0) {
+			for (uint8_t x = MATRIX_NUM_COLUMNS - 1; x > 0; x--) {
+				copy_matrix_column(shadow[x - 1], shadow[x]);
+			}
+			set_matrix_column_to_colour(shadow[0], 0);
+			for (uint8_t y = 0; y < MATRIX_NUM_ROWS; y++) {
+				dirty[y] = (dirty[y] << 1) | 1;
+			}
+		}
+		else {
+			uint8_t from = (dy > 0) ? MATRIX_NUM_ROWS - 2 : 1;
+			uint8_t blank = (dy > 0) ? 0 : MATRIX_NUM_ROWS - 1;
+			
+			for (uint8_t i = 0; i < MATRIX_NUM_ROWS - 1; i++, from -= dy) {
+				for (uint8_t x = 0; x < MATRIX_NUM_COLUMNS; x++) {
+					shadow[x][from + dy] = shadow[x][from];
+				}
+				dirty[from + dy] = dirty[from];
+			}
+			for (uint8_t x = 0; x < MATRIX_NUM_COLUMNS; x++) {
+				shadow[x][blank] = 0;
+			}
+			dirty[blank] = 0xFFFF;
+		}
+		
+		shift_pending_x += dx;
+		shift_pending_y += dy;
 	}
 }
 
 void ledmatrix_shift_display_left(void) {
-	(void)spi_send_byte(CMD_SHIFT_DISPLAY);
-	(void)spi_send_byte(0x02);
+	shift_shadow(-1, 0);
 }
 
 void ledmatrix_shift_display_right(void) {
-	(void)spi_send_byte(CMD_SHIFT_DISPLAY);
-	(void)spi_send_byte(0x01);
+	shift_shadow(1, 0);
 }
 
 void ledmatrix_shift_display_up(void) {
-	(void)spi_send_byte(CMD_SHIFT_DISPLAY);
-	(void)spi_send_byte(0x08);
+	shift_shadow(0, 1);
 }
 
 void ledmatrix_shift_display_down(void) {
-	(void)spi_send_byte(CMD_SHIFT_DISPLAY);
-	(void)spi_send_byte(0x04);
+	shift_shadow(0, -1);
 }
 
 void ledmatrix_clear(void) {
-	(void)spi_send_byte(CMD_CLEAR_SCREEN);
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		for (uint8_t x = 0; x < MATRIX_NUM_COLUMNS; x++) {
+			set_matrix_column_to_colour(shadow[x], 0);
+		}
+		for (uint8_t y = 0; y < MATRIX_NUM_ROWS; y++) {
+			dirty[y] = 0;
+		}
+		// Shifts of a blank screen change nothing
+		shift_pending_x = 0;
+		shift_pending_y = 0;
+		clear_pending = 1;
+	}
 }
 
 void copy_matrix_column(MatrixColumn from, MatrixColumn to) {
@@ -28,6 +28,12 @@ typedef PixelColour MatrixColumn[MATRIX_NUM_ROWS];
 // below are used.
 void ledmatrix_setup(void);
 
+// The functions below only draw into a copy of the matrix in RAM (and may be
+// called from interrupt handlers). ledmatrix_flush() sends what has changed
+// since it was last called, as much as fits in the SPI transmit queue without
+// waiting, and must be called regularly from the main loop.
+void ledmatrix_flush(void);
+
 // Functions to update the display
 // For those functions which take an x or a y value, the value must be valid
 // or the request will be ignored. (i.e. x must be < MATRIX_NUM_COLUMNS
@@ -0,0 +1,603 @@
+/*
+ * level_pack.h
+ *
+ * Generated by tools/levelc.c from the files in levels/. Do not edit,
+ * change the level files and run levelc again.
+ */ 
+
+#ifndef LEVEL_PACK_H_
+#define LEVEL_PACK_H_
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+#define LEVEL_PACK_COUNT 32
+#define LEVEL_PACK_HEIGHT 16
+
+static const uint8_t level_pack[] PROGMEM = {
+	// level01.txt
+	0x10, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x02,
+	0x0C, 0xED, 0x00, 0x00, 0xA0, 0x09, 0xAA, 0x80,
+	0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0xC0, 0x00,
+	0x9A, 0xAA, 0x80, 0x00, 0x00, 0x00, 0x0E, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xCE, 0xD0, 0x00, 0xD0,
+	0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x0E, 0x00, 0x00, 0x9A, 0xA8, 0x00, 0x00,
+	0x00, 0x00, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x00,
+	8,
+	0x34, 0x30, 0x30, 3, 0x33, 0x32, 0x31,	// Snake 1
+	0x09, 0x27, 0x27, 1, 0x18,	// Snake 2
+	0x6B, 0x68, 0x68, 2, 0x6A, 0x69,	// Snake 3
+	0x1E, 0x1B, 0x1B, 2, 0x1D, 0x1C,	// Snake 4
+	0x52, 0x74, 0x74, 1, 0x63,	// Ladder 1
+	0x11, 0x13, 0x13, 1, 0x12,	// Ladder 2
+	0x48, 0x4A, 0x4A, 1, 0x49,	// Ladder 3
+	0x2C, 0x4E, 0x4E, 1, 0x3D,	// Ladder 4
+	// level02.txt
+	0x10, 0x00, 0x00, 0xCE, 0xEE, 0xED, 0x00, 0x02,
+	0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x0A, 0x00, 0x00, 0x90, 0x00, 0x09, 0xA8,
+	0xCE, 0xFE, 0xD0, 0x00, 0x0A, 0x0D, 0x00, 0x00,
+	0x0A, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x00, 0x0D,
+	0x90, 0x00, 0x00, 0x00, 0x0E, 0x0A, 0x00, 0xE0,
+	0x00, 0x09, 0xAA, 0xA8, 0xE0, 0x00, 0xAC, 0x00,
+	0x00, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x08, 0x00,
+	8,
+	0x14, 0x50, 0x50, 3, 0x23, 0x32, 0x41,	// Snake 1
+	0x67, 0x63, 0x63, 3, 0x66, 0x65, 0x64,	// Snake 2
+	0x7D, 0x28, 0x28, 4, 0x6C, 0x5B, 0x4A, 0x39,	// Snake 3
+	0x2F, 0x2D, 0x2D, 1, 0x2E,	// Snake 4
+	0x30, 0x34, 0x34, 3, 0x31, 0x32, 0x33,	// Ladder 1
+	0x77, 0x3B, 0x3B, 3, 0x68, 0x59, 0x4A,	// Ladder 2
+	0x06, 0x0B, 0x0B, 4, 0x07, 0x08, 0x09, 0x0A,	// Ladder 3
+	0x6D, 0x4F, 0x4F, 1, 0x5E,	// Ladder 4
+	// level03.txt
+	0x10, 0x00, 0xCE, 0xD0, 0x00, 0xC0, 0x00, 0x02,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x0E, 0xED, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x9A, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x80, 0x00, 0x80, 0x00, 0x00,
+	0x00, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x0C, 0x00,
+	0x00, 0x09, 0xA0, 0x00, 0x00, 0x00, 0x00, 0xE0,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x0E,
+	0x09, 0xAA, 0xAA, 0xAA, 0x80, 0x9A, 0x00, 0x0D,
+	7,
+	0x78, 0x71, 0x71, 6, 0x77, 0x76, 0x75, 0x74, 0x73, 0x72,	// Snake 1
+	0x3A, 0x28, 0x28, 1, 0x29,	// Snake 2
+	0x6C, 0x7A, 0x7A, 1, 0x7B,	// Snake 3
+	0x36, 0x53, 0x53, 2, 0x45, 0x54,	// Snake 4
+	0x04, 0x06, 0x06, 1, 0x05,	// Ladder 1
+	0x0A, 0x1D, 0x1D, 2, 0x1B, 0x1C,	// Ladder 2
+	0x4D, 0x7F, 0x7F, 2, 0x5E, 0x6F,	// Ladder 3
+	// level04.txt
+	0x10, 0x00, 0x00, 0x9A, 0xAA, 0xA0, 0x00, 0x02,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00,
+	0x0C, 0xEE, 0xEE, 0xD0, 0x00, 0x00, 0x0C, 0xED,
+	0x00, 0x00, 0x00, 0x00, 0x9A, 0xAA, 0x00, 0x00,
+	0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00,
+	0x00, 0x0E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0xE0, 0x00, 0x00, 0x00, 0x00, 0xED,
+	0x00, 0x00, 0xD0, 0x9A, 0xAA, 0xA8, 0x0C, 0x00,
+	7,
+	0x4C, 0x38, 0x38, 3, 0x3B, 0x3A, 0x39,	// Snake 1
+	0x1B, 0x06, 0x06, 4, 0x0A, 0x09, 0x08, 0x07,	// Snake 2
+	0x7B, 0x76, 0x76, 4, 0x7A, 0x79, 0x78, 0x77,	// Snake 3
+	0x42, 0x74, 0x74, 2, 0x53, 0x64,	// Ladder 1
+	0x21, 0x26, 0x26, 4, 0x22, 0x23, 0x24, 0x25,	// Ladder 2
+	0x2D, 0x2F, 0x2F, 1, 0x2E,	// Ladder 3
+	0x7D, 0x6F, 0x6F, 1, 0x6E,	// Ladder 4
+	// level05.txt
+	0x10, 0x00, 0xD0, 0x00, 0x00, 0x09, 0xA0, 0x02,
+	0x00, 0x0E, 0x00, 0x0D, 0x00, 0x00, 0x0A, 0x00,
+	0x00, 0xC0, 0x00, 0xE0, 0x00, 0x00, 0x00, 0x80,
+	0x00, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x80,
+	0x00, 0x09, 0xA0, 0x0A, 0x00, 0x9A, 0xAA, 0x00,
+	0x00, 0x00, 0x0A, 0x00, 0xA0, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x80, 0x08, 0x0C, 0xED, 0x00,
+	7,
+	0x76, 0x53, 0x53, 2, 0x65, 0x54,	// Snake 1
+	0x2E, 0x0B, 0x0B, 2, 0x1D, 0x0C,	// Snake 2
+	0x4E, 0x5A, 0x5A, 3, 0x5D, 0x5C, 0x5B,	// Snake 3
+	0x79, 0x47, 0x47, 2, 0x68, 0x57,	// Snake 4
+	0x35, 0x17, 0x17, 1, 0x26,	// Ladder 1
+	0x7B, 0x7D, 0x7D, 1, 0x7C,	// Ladder 2
+	0x22, 0x04, 0x04, 1, 0x13,	// Ladder 3
+	// level06.txt
+	0x10, 0x0C, 0xEE, 0xD0, 0x00, 0x00, 0x00, 0x02,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x9A, 0xA8, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x08, 0x00, 0xCE, 0xD0, 0x00,
+	0x00, 0x09, 0xAA, 0xA0, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x9A, 0xAA, 0xA8, 0x00,
+	0x0C, 0xEE, 0xEE, 0xD0, 0x00, 0x00, 0x00, 0x00,
+	6,
+	0x37, 0x43, 0x43, 3, 0x46, 0x45, 0x44,	// Snake 1
+	0x6D, 0x68, 0x68, 4, 0x6C, 0x6B, 0x6A, 0x69,	// Snake 2
+	0x1D, 0x1A, 0x1A, 2, 0x1C, 0x1B,	// Snake 3
+	0x71, 0x76, 0x76, 4, 0x72, 0x73, 0x74, 0x75,	// Ladder 1
+	0x03, 0x06, 0x06, 2, 0x04, 0x05,	// Ladder 2
+	0x3A, 0x3C, 0x3C, 1, 0x3B,	// Ladder 3
+	// level07.txt
+	0x10, 0xED, 0x00, 0x9A, 0xAA, 0x80, 0x0C, 0x02,
+	0x0C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0,
+	0x00, 0x08, 0x00, 0x00, 0x9A, 0xAA, 0xA0, 0x0E,
+	0x9A, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x08, 0x0D,
+	0x00, 0x00, 0x09, 0xAA, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0xC0, 0x00, 0x00, 0xA0, 0x00, 0x00, 0x00,
+	0x00, 0x0E, 0x00, 0x00, 0x08, 0x00, 0x08, 0x00,
+	0x00, 0x00, 0xED, 0x00, 0x00, 0x09, 0xA0, 0x00,
+	8,
+	0x0A, 0x06, 0x06, 3, 0x09, 0x08, 0x07,	// Snake 1
+	0x69, 0x45, 0x45, 3, 0x58, 0x47, 0x46,	// Snake 2
+	0x23, 0x30, 0x30, 2, 0x32, 0x31,	// Snake 3
+	0x3D, 0x28, 0x28, 4, 0x2C, 0x2B, 0x2A, 0x29,	// Snake 4
+	0x6D, 0x7B, 0x7B, 1, 0x7C,	// Snake 5
+	0x52, 0x75, 0x75, 2, 0x63, 0x74,	// Ladder 1
+	0x0D, 0x3F, 0x3F, 2, 0x1E, 0x2F,	// Ladder 2
+	0x11, 0x03, 0x03, 1, 0x02,	// Ladder 3
+	// level08.txt
+	0x10, 0x9A, 0xAA, 0xAA, 0xA8, 0x00, 0x00, 0x02,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x00,
+	0x0C, 0x00, 0x00, 0x09, 0xA8, 0x00, 0x00, 0xED,
+	0x00, 0xED, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x0E, 0xD0, 0x00, 0x00, 0x00, 0xD0,
+	0x00, 0x00, 0xE0, 0x00, 0x00, 0x80, 0x0E, 0x00,
+	0x00, 0x0E, 0x00, 0x00, 0x9A, 0x00, 0xC0, 0x00,
+	0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	7,
+	0x09, 0x02, 0x02, 6, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03,	// Snake 1
+	0x5A, 0x68, 0x68, 1, 0x69,	// Snake 2
+	0x29, 0x27, 0x27, 1, 0x28,	// Snake 3
+	0x72, 0x46, 0x46, 3, 0x63, 0x54, 0x45,	// Ladder 1
+	0x1D, 0x2F, 0x2F, 1, 0x2E,	// Ladder 2
+	0x21, 0x33, 0x33, 1, 0x32,	// Ladder 3
+	0x6C, 0x4E, 0x4E, 1, 0x5D,	// Ladder 4
+	// level09.txt
+	0x10, 0x00, 0xEE, 0xEE, 0xD0, 0x00, 0x00, 0xD2,
+	0x00, 0x0E, 0x00, 0x00, 0x00, 0x08, 0x00, 0xE0,
+	0x00, 0xC0, 0x00, 0x9A, 0xAA, 0xA0, 0x0E, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x00,
+	0x9A, 0xAA, 0xAA, 0xA8, 0x00, 0x00, 0x00, 0x0D,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x0E,
+	0x00, 0x00, 0x9A, 0xAA, 0xAA, 0xA0, 0x00, 0xE0,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x00,
+	6,
+	0x1B, 0x26, 0x26, 4, 0x2A, 0x29, 0x28, 0x27,	// Snake 1
+	0x47, 0x40, 0x40, 6, 0x46, 0x45, 0x44, 0x43, 0x42, 0x41,	// Snake 2
+	0x5B, 0x64, 0x64, 6, 0x6A, 0x69, 0x68, 0x67, 0x66, 0x65,	// Snake 3
+	0x22, 0x08, 0x08, 5, 0x13, 0x04, 0x05, 0x06, 0x07,	// Ladder 1
+	0x7D, 0x4F, 0x4F, 2, 0x6E, 0x5F,	// Ladder 2
+	0x3C, 0x0E, 0x0E, 2, 0x2D, 0x1E,	// Ladder 3
+	// level10.txt
+	0x1C, 0xEE, 0xD0, 0x00, 0x08, 0x00, 0x00, 0x02,
+	0x00, 0x00, 0x00, 0x00, 0xA0, 0x00, 0x00, 0x00,
+	0x09, 0xA0, 0x00, 0x9A, 0x00, 0xED, 0x00, 0x00,
+	0x00, 0x0A, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x80, 0x00, 0xE0, 0x00, 0x08, 0x00,
+	0x00, 0x00, 0x00, 0x0C, 0x00, 0x00, 0xA0, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00,
+	0x00, 0x00, 0xCE, 0xD0, 0x00, 0x09, 0x00, 0x00,
+	6,
+	0x44, 0x21, 0x21, 2, 0x33, 0x22,	// Snake 1
+	0x09, 0x26, 0x26, 2, 0x18, 0x27,	// Snake 2
+	0x4D, 0x7B, 0x7B, 2, 0x5C, 0x6B,	// Snake 3
+	0x57, 0x2B, 0x2B, 3, 0x48, 0x39, 0x2A,	// Ladder 1
+	0x74, 0x76, 0x76, 1, 0x75,	// Ladder 2
+	0x01, 0x04, 0x04, 2, 0x02, 0x03,	// Ladder 3
+	// level11.txt
+	0x1C, 0xEE, 0xD0, 0xCE, 0xEE, 0xEE, 0xED, 0x02,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x0C, 0x00, 0x9A, 0xA0, 0x00, 0x00, 0x80, 0x00,
+	0x00, 0xE0, 0x00, 0x08, 0x00, 0x0A, 0x00, 0xD0,
+	0x00, 0x0E, 0x00, 0x00, 0x00, 0xA0, 0x00, 0xE0,
+	0x00, 0x0D, 0x00, 0x00, 0x9A, 0x00, 0x0E, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x00,
+	0x00, 0x00, 0x9A, 0xAA, 0xA8, 0x00, 0x00, 0x00,
+	7,
+	0x2C, 0x58, 0x58, 3, 0x3B, 0x4A, 0x59,	// Snake 1
+	0x79, 0x74, 0x74, 4, 0x78, 0x77, 0x76, 0x75,	// Snake 2
+	0x37, 0x24, 0x24, 2, 0x26, 0x25,	// Snake 3
+	0x21, 0x53, 0x53, 2, 0x32, 0x43,	// Ladder 1
+	0x6C, 0x3E, 0x3E, 2, 0x5D, 0x4E,	// Ladder 2
+	0x06, 0x0D, 0x0D, 6, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C,	// Ladder 3
+	0x01, 0x04, 0x04, 2, 0x02, 0x03,	// Ladder 4
+	// level12.txt
+	0x10, 0x9A, 0xAA, 0xA0, 0x09, 0xAA, 0xAA, 0x82,
+	0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x09, 0x00, 0x00, 0x80, 0x0E, 0xD0, 0x00,
+	0x00, 0x0A, 0x00, 0x00, 0x00, 0xC0, 0x00, 0x00,
+	0x0C, 0x00, 0xA0, 0x00, 0x00, 0x00, 0x80, 0x00,
+	0x00, 0xE0, 0x08, 0x00, 0x00, 0x0A, 0x00, 0x0D,
+	0x00, 0x0E, 0x00, 0x00, 0x00, 0x90, 0x00, 0xE0,
+	0x00, 0x00, 0xEE, 0xEE, 0xD0, 0x00, 0x0C, 0x00,
+	7,
+	0x4C, 0x6A, 0x6A, 1, 0x5B,	// Snake 1
+	0x0E, 0x09, 0x09, 4, 0x0D, 0x0C, 0x0B, 0x0A,	// Snake 2
+	0x55, 0x23, 0x23, 2, 0x44, 0x33,	// Snake 3
+	0x28, 0x02, 0x02, 5, 0x17, 0x06, 0x05, 0x04, 0x03,	// Snake 4
+	0x7D, 0x5F, 0x5F, 1, 0x6E,	// Ladder 1
+	0x3A, 0x2C, 0x2C, 1, 0x2B,	// Ladder 2
+	0x41, 0x78, 0x78, 6, 0x52, 0x63, 0x74, 0x75, 0x76, 0x77,	// Ladder 3
+	// level13.txt
+	0x10, 0x00, 0x09, 0xA8, 0x00, 0x00, 0xC0, 0x02,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0E, 0xD0,
+	0x00, 0x09, 0xAA, 0x80, 0x00, 0x9A, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x80, 0x00,
+	0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x9A, 0xA0, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x0C, 0xEE, 0xED, 0x00,
+	0x00, 0x0C, 0xEE, 0xD0, 0x00, 0x00, 0x00, 0x00,
+	7,
+	0x38, 0x54, 0x54, 3, 0x47, 0x56, 0x55,	// Snake 1
+	0x3C, 0x2A, 0x2A, 1, 0x2B,	// Snake 2
+	0x26, 0x23, 0x23, 2, 0x25, 0x24,	// Snake 3
+	0x07, 0x05, 0x05, 1, 0x06,	// Snake 4
+	0x69, 0x6D, 0x6D, 3, 0x6A, 0x6B, 0x6C,	// Ladder 1
+	0x0C, 0x1E, 0x1E, 1, 0x1D,	// Ladder 2
+	0x73, 0x76, 0x76, 2, 0x74, 0x75,	// Ladder 3
+	// level14.txt
+	0x10, 0x09, 0x00, 0x00, 0xED, 0x00, 0x80, 0x02,
+	0x00, 0x00, 0xA0, 0x0C, 0x00, 0x0A, 0x00, 0x00,
+	0x00, 0x00, 0x08, 0x00, 0x00, 0xA0, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x09, 0xAA, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x09, 0xAA, 0xAA, 0x00, 0x0C, 0xEE, 0xED,
+	0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00,
+	0x0C, 0xED, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	6,
+	0x68, 0x53, 0x53, 4, 0x57, 0x56, 0x55, 0x54,	// Snake 1
+	0x25, 0x03, 0x03, 1, 0x14,	// Snake 2
+	0x0C, 0x37, 0x37, 4, 0x1B, 0x2A, 0x39, 0x38,	// Snake 3
+	0x17, 0x09, 0x09, 1, 0x08,	// Ladder 1
+	0x5B, 0x5F, 0x5F, 3, 0x5C, 0x5D, 0x5E,	// Ladder 2
+	0x71, 0x73, 0x73, 1, 0x72,	// Ladder 3
+	// level15.txt
+	0x10, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+	0x00, 0x0E, 0x00, 0xCE, 0xED, 0x00, 0x80, 0x00,
+	0x00, 0x00, 0xD0, 0x00, 0x00, 0x0A, 0x00, 0x00,
+	0x9A, 0x80, 0x00, 0x00, 0x9A, 0xA0, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0xCE, 0xD0, 0x00, 0x9A, 0xAA, 0xAA, 0x80,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	6,
+	0x5E, 0x58, 0x58, 5, 0x5D, 0x5C, 0x5B, 0x5A, 0x59,	// Snake 1
+	0x32, 0x30, 0x30, 1, 0x31,	// Snake 2
+	0x1C, 0x38, 0x38, 3, 0x2B, 0x3A, 0x39,	// Snake 3
+	0x52, 0x54, 0x54, 1, 0x53,	// Ladder 1
+	0x02, 0x24, 0x24, 1, 0x13,	// Ladder 2
+	0x16, 0x19, 0x19, 2, 0x17, 0x18,	// Ladder 3
+	// level16.txt
+	0x10, 0x00, 0x00, 0x00, 0xCE, 0xEE, 0xED, 0x02,
+	0x00, 0xEE, 0xED, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x0C, 0x00, 0x00, 0x00, 0x00, 0x09, 0xAA, 0x80,
+	0x00, 0x00, 0x9A, 0x80, 0xC0, 0x00, 0x00, 0x00,
+	0x0C, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00,
+	0x00, 0xEE, 0xD0, 0x00, 0x00, 0xD0, 0x00, 0xED,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0E, 0x00,
+	0x00, 0x00, 0x09, 0xAA, 0xA8, 0x00, 0xC0, 0x00,
+	8,
+	0x36, 0x34, 0x34, 1, 0x35,	// Snake 1
+	0x79, 0x75, 0x75, 3, 0x78, 0x77, 0x76,	// Snake 2
+	0x2E, 0x2B, 0x2B, 2, 0x2D, 0x2C,	// Snake 3
+	0x38, 0x5A, 0x5A, 1, 0x49,	// Ladder 1
+	0x7C, 0x5F, 0x5F, 2, 0x6D, 0x5E,	// Ladder 2
+	0x21, 0x15, 0x15, 3, 0x12, 0x13, 0x14,	// Ladder 3
+	0x41, 0x54, 0x54, 2, 0x52, 0x53,	// Ladder 4
+	0x08, 0x0D, 0x0D, 4, 0x09, 0x0A, 0x0B, 0x0C,	// Ladder 5
+	// level17.txt
+	0x10, 0x00, 0x00, 0x09, 0xAA, 0xAA, 0xA8, 0x02,
+	0x0C, 0xED, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0xED, 0x00,
+	0x00, 0x00, 0x09, 0xA0, 0x00, 0x00, 0x00, 0x0D,
+	0x09, 0xA0, 0x00, 0x08, 0x00, 0x08, 0x00, 0xE0,
+	0x00, 0x0A, 0x00, 0x00, 0x00, 0xA0, 0x0E, 0x00,
+	0x00, 0x00, 0xA0, 0x00, 0x0A, 0x00, 0xC0, 0x00,
+	0x00, 0x00, 0x08, 0x09, 0xA0, 0x00, 0x00, 0x00,
+	7,
+	0x4B, 0x77, 0x77, 3, 0x5A, 0x69, 0x78,	// Snake 1
+	0x75, 0x41, 0x41, 3, 0x64, 0x53, 0x42,	// Snake 2
+	0x0D, 0x07, 0x07, 5, 0x0C, 0x0B, 0x0A, 0x09, 0x08,	// Snake 3
+	0x47, 0x35, 0x35, 1, 0x36,	// Snake 4
+	0x2B, 0x2D, 0x2D, 1, 0x2C,	// Ladder 1
+	0x6C, 0x3F, 0x3F, 2, 0x5D, 0x4E,	// Ladder 2
+	0x11, 0x13, 0x13, 1, 0x12,	// Ladder 3
+	// level18.txt
+	0x10, 0xCE, 0xD0, 0xCE, 0xD0, 0x00, 0x00, 0x02,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x90, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x08, 0x00, 0x0A, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0xA0, 0x00, 0x00, 0xA0, 0x00,
+	0x00, 0x00, 0x0A, 0x00, 0x08, 0x00, 0x08, 0x00,
+	0x00, 0x9A, 0xA0, 0x00, 0xA0, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x00,
+	0x0C, 0xED, 0x09, 0xA0, 0x00, 0x0C, 0xEE, 0xED,
+	7,
+	0x27, 0x52, 0x52, 4, 0x36, 0x45, 0x54, 0x53,	// Snake 1
+	0x49, 0x75, 0x75, 3, 0x58, 0x67, 0x76,	// Snake 2
+	0x4D, 0x1A, 0x1A, 2, 0x3C, 0x2B,	// Snake 3
+	0x7B, 0x7F, 0x7F, 3, 0x7C, 0x7D, 0x7E,	// Ladder 1
+	0x71, 0x73, 0x73, 1, 0x72,	// Ladder 2
+	0x06, 0x08, 0x08, 1, 0x07,	// Ladder 3
+	0x02, 0x04, 0x04, 1, 0x03,	// Ladder 4
+	// level19.txt
+	0x10, 0x9A, 0x00, 0x00, 0x00, 0x9A, 0x00, 0x02,
+	0x00, 0x00, 0x80, 0x0E, 0xD0, 0x00, 0x80, 0x00,
+	0x90, 0x00, 0x00, 0xE0, 0x00, 0x80, 0x00, 0x00,
+	0x0A, 0x00, 0x0C, 0x00, 0x0A, 0x00, 0x00, 0x00,
+	0x00, 0xA0, 0x00, 0x00, 0xA0, 0x00, 0xCE, 0xED,
+	0x00, 0x08, 0x00, 0x9A, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0xEE, 0xED,
+	0x09, 0xAA, 0xAA, 0xAA, 0x80, 0x00, 0x00, 0x00,
+	8,
+	0x53, 0x20, 0x20, 2, 0x42, 0x31,	// Snake 1
+	0x2A, 0x56, 0x56, 3, 0x39, 0x48, 0x57,	// Snake 2
+	0x14, 0x02, 0x02, 1, 0x03,	// Snake 3
+	0x78, 0x71, 0x71, 6, 0x77, 0x76, 0x75, 0x74, 0x73, 0x72,	// Snake 4
+	0x1C, 0x0A, 0x0A, 1, 0x0B,	// Snake 5
+	0x4C, 0x4F, 0x4F, 2, 0x4D, 0x4E,	// Ladder 1
+	0x6B, 0x6F, 0x6F, 3, 0x6C, 0x6D, 0x6E,	// Ladder 2
+	0x35, 0x18, 0x18, 2, 0x26, 0x17,	// Ladder 3
+	// level20.txt
+	0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+	0x00, 0xCE, 0xD0, 0x00, 0x9A, 0xAA, 0xA8, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x09, 0xAA, 0x80, 0x00, 0xCE, 0xEE, 0xD0, 0x00,
+	0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0xD0,
+	0x00, 0x00, 0x0A, 0x00, 0x00, 0x08, 0x00, 0xE0,
+	0x00, 0x00, 0xA0, 0x00, 0x00, 0xA0, 0x0E, 0x00,
+	0x00, 0x09, 0x00, 0x00, 0x9A, 0x00, 0xC0, 0x00,
+	7,
+	0x5B, 0x78, 0x78, 2, 0x6A, 0x79,	// Snake 1
+	0x1D, 0x18, 0x18, 4, 0x1C, 0x1B, 0x1A, 0x19,	// Snake 2
+	0x46, 0x73, 0x73, 2, 0x55, 0x64,	// Snake 3
+	0x34, 0x31, 0x31, 2, 0x33, 0x32,	// Snake 4
+	0x7C, 0x4E, 0x4E, 2, 0x6D, 0x5E,	// Ladder 1
+	0x38, 0x3C, 0x3C, 3, 0x39, 0x3A, 0x3B,	// Ladder 2
+	0x12, 0x14, 0x14, 1, 0x13,	// Ladder 3
+	// level21.txt
+	0x10, 0x9A, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x02,
+	0x00, 0x00, 0x0A, 0x00, 0x0E, 0xEE, 0xEE, 0xD0,
+	0x0C, 0x00, 0x00, 0x80, 0xC0, 0x00, 0x00, 0x00,
+	0x00, 0xE0, 0x00, 0x00, 0x00, 0x08, 0x00, 0x0D,
+	0x00, 0x0E, 0xD0, 0x9A, 0xAA, 0xA0, 0x00, 0x0E,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0,
+	0x00, 0x0C, 0x00, 0x00, 0x00, 0x08, 0x0C, 0x00,
+	0x00, 0x00, 0xEE, 0xD0, 0x9A, 0xA0, 0x00, 0x00,
+	7,
+	0x6B, 0x78, 0x78, 2, 0x7A, 0x79,	// Snake 1
+	0x26, 0x02, 0x02, 3, 0x15, 0x04, 0x03,	// Snake 2
+	0x3B, 0x46, 0x46, 4, 0x4A, 0x49, 0x48, 0x47,	// Snake 3
+	0x21, 0x44, 0x44, 2, 0x32, 0x43,	// Ladder 1
+	0x6D, 0x3F, 0x3F, 2, 0x5E, 0x4F,	// Ladder 2
+	0x63, 0x76, 0x76, 2, 0x74, 0x75,	// Ladder 3
+	0x28, 0x1E, 0x1E, 5, 0x19, 0x1A, 0x1B, 0x1C, 0x1D,	// Ladder 4
+	// level22.txt
+	0x10, 0x00, 0x00, 0x00, 0x9A, 0xAA, 0xA0, 0x02,
+	0x9A, 0xAA, 0xAA, 0x00, 0x00, 0x00, 0x08, 0x00,
+	0x00, 0x00, 0x00, 0x80, 0x0C, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x90, 0x00, 0x00, 0xEE, 0xED, 0x00,
+	0x00, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x0D, 0x00, 0x80, 0x00, 0x0E, 0xEE, 0xED,
+	0x00, 0xE0, 0x00, 0x00, 0x00, 0xC0, 0x00, 0x00,
+	0x0C, 0x00, 0xCE, 0xD0, 0x00, 0x00, 0xCE, 0xED,
+	8,
+	0x1D, 0x08, 0x08, 4, 0x0C, 0x0B, 0x0A, 0x09,	// Snake 1
+	0x56, 0x34, 0x34, 1, 0x45,	// Snake 2
+	0x26, 0x10, 0x10, 5, 0x15, 0x14, 0x13, 0x12, 0x11,	// Snake 3
+	0x6A, 0x5F, 0x5F, 4, 0x5B, 0x5C, 0x5D, 0x5E,	// Ladder 1
+	0x71, 0x53, 0x53, 1, 0x62,	// Ladder 2
+	0x29, 0x3D, 0x3D, 3, 0x3A, 0x3B, 0x3C,	// Ladder 3
+	0x7C, 0x7F, 0x7F, 2, 0x7D, 0x7E,	// Ladder 4
+	0x74, 0x76, 0x76, 1, 0x75,	// Ladder 5
+	// level23.txt
+	0x10, 0x00, 0x00, 0x9A, 0xAA, 0xAA, 0x00, 0x02,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x0C, 0x00, 0x09, 0xA0, 0x00, 0x0E, 0xD0, 0x00,
+	0x00, 0xE0, 0x00, 0x08, 0x00, 0xC0, 0x00, 0x00,
+	0x00, 0x0E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80,
+	0x00, 0x0D, 0x0C, 0xED, 0x00, 0x00, 0x0A, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x09, 0xAA, 0xA0, 0x00,
+	6,
+	0x47, 0x35, 0x35, 1, 0x36,	// Snake 1
+	0x1C, 0x06, 0x06, 5, 0x0B, 0x0A, 0x09, 0x08, 0x07,	// Snake 2
+	0x5E, 0x79, 0x79, 4, 0x6D, 0x7C, 0x7B, 0x7A,	// Snake 3
+	0x4A, 0x3C, 0x3C, 1, 0x3B,	// Ladder 1
+	0x31, 0x63, 0x63, 2, 0x42, 0x53,	// Ladder 2
+	0x65, 0x67, 0x67, 1, 0x66,	// Ladder 3
+	// level24.txt
+	0x10, 0x00, 0x9A, 0xA0, 0x00, 0x00, 0x00, 0x02,
+	0x00, 0xC0, 0x00, 0x0A, 0x00, 0x00, 0x0C, 0xED,
+	0x00, 0x0E, 0xED, 0x00, 0x80, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0xCE, 0xEE, 0xED,
+	0x00, 0x09, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x0A, 0x00, 0x9A, 0xAA, 0xAA, 0x00,
+	0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x80,
+	0x00, 0x00, 0x00, 0x00, 0x0C, 0xED, 0x00, 0x00,
+	7,
+	0x66, 0x43, 0x43, 2, 0x55, 0x44,	// Snake 1
+	0x6E, 0x58, 0x58, 5, 0x5D, 0x5C, 0x5B, 0x5A, 0x59,	// Snake 2
+	0x28, 0x04, 0x04, 3, 0x17, 0x06, 0x05,	// Snake 3
+	0x1D, 0x1F, 0x1F, 1, 0x1E,	// Ladder 1
+	0x3A, 0x3F, 0x3F, 4, 0x3B, 0x3C, 0x3D, 0x3E,	// Ladder 2
+	0x12, 0x25, 0x25, 2, 0x23, 0x24,	// Ladder 3
+	0x79, 0x7B, 0x7B, 1, 0x7A,	// Ladder 4
+	// level25.txt
+	0x10, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x02,
+	0x00, 0x00, 0x00, 0x00, 0xA0, 0x0E, 0xD0, 0xD0,
+	0x00, 0x08, 0x00, 0x9A, 0x00, 0xC0, 0x00, 0xE0,
+	0x00, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x0E, 0x00,
+	0x9A, 0x00, 0x0C, 0xEE, 0xED, 0x00, 0xC0, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x09, 0xAA, 0xAA, 0xAA, 0x80,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	6,
+	0x09, 0x26, 0x26, 2, 0x18, 0x27,	// Snake 1
+	0x6E, 0x67, 0x67, 6, 0x6D, 0x6C, 0x6B, 0x6A, 0x69, 0x68,	// Snake 2
+	0x23, 0x40, 0x40, 2, 0x32, 0x41,	// Snake 3
+	0x4C, 0x1E, 0x1E, 2, 0x3D, 0x2E,	// Ladder 1
+	0x45, 0x49, 0x49, 3, 0x46, 0x47, 0x48,	// Ladder 2
+	0x2A, 0x1C, 0x1C, 1, 0x1B,	// Ladder 3
+	// level26.txt
+	0x10, 0x00, 0x00, 0x00, 0x00, 0x0C, 0xED, 0x02,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x9A, 0x00, 0x00, 0x09, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0xA0, 0x00, 0x00, 0xA0, 0x00,
+	0x00, 0x0E, 0xD0, 0x08, 0x00, 0x00, 0x08, 0x00,
+	0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x0C, 0xEE, 0xEE, 0xEE, 0xD0, 0x00,
+	0x09, 0xA8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	6,
+	0x47, 0x24, 0x24, 2, 0x36, 0x25,	// Snake 1
+	0x4D, 0x2B, 0x2B, 1, 0x3C,	// Snake 2
+	0x73, 0x71, 0x71, 1, 0x72,	// Snake 3
+	0x65, 0x6C, 0x6C, 6, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x6B,	// Ladder 1
+	0x52, 0x44, 0x44, 1, 0x43,	// Ladder 2
+	0x0B, 0x0D, 0x0D, 1, 0x0C,	// Ladder 3
+	// level27.txt
+	0x1C, 0xEE, 0xD0, 0x08, 0x00, 0xC0, 0x00, 0x02,
+	0x00, 0x00, 0x00, 0xA0, 0x00, 0x0E, 0x00, 0x00,
+	0x00, 0x00, 0x0A, 0x00, 0x00, 0x00, 0xED, 0x00,
+	0x09, 0xAA, 0xA0, 0x00, 0x9A, 0x80, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x9A, 0xAA, 0xAA, 0xA8, 0x00,
+	0x9A, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x08, 0x00, 0x00, 0x0C, 0xEE, 0xEE, 0xED,
+	7,
+	0x07, 0x31, 0x31, 5, 0x16, 0x25, 0x34, 0x33, 0x32,	// Snake 1
+	0x5D, 0x56, 0x56, 6, 0x5C, 0x5B, 0x5A, 0x59, 0x58, 0x57,	// Snake 2
+	0x73, 0x60, 0x60, 2, 0x62, 0x61,	// Snake 3
+	0x3A, 0x38, 0x38, 1, 0x39,	// Snake 4
+	0x0A, 0x2D, 0x2D, 2, 0x1B, 0x2C,	// Ladder 1
+	0x79, 0x7F, 0x7F, 5, 0x7A, 0x7B, 0x7C, 0x7D, 0x7E,	// Ladder 2
+	0x01, 0x04, 0x04, 2, 0x02, 0x03,	// Ladder 3
+	// level28.txt
+	0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x02,
+	0x00, 0x00, 0xCE, 0xEE, 0xED, 0x00, 0x0E, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0,
+	0x0C, 0x00, 0x09, 0xAA, 0xAA, 0xA8, 0x00, 0x0D,
+	0x00, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x00,
+	0x00, 0x0D, 0x00, 0x9A, 0xA8, 0x00, 0x00, 0xED,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x9A, 0xA8, 0x00, 0x00, 0x00, 0x9A, 0x80, 0x00,
+	8,
+	0x3B, 0x35, 0x35, 5, 0x3A, 0x39, 0x38, 0x37, 0x36,	// Snake 1
+	0x7C, 0x7A, 0x7A, 1, 0x7B,	// Snake 2
+	0x73, 0x70, 0x70, 2, 0x72, 0x71,	// Snake 3
+	0x59, 0x56, 0x56, 2, 0x58, 0x57,	// Snake 4
+	0x14, 0x19, 0x19, 4, 0x15, 0x16, 0x17, 0x18,	// Ladder 1
+	0x0C, 0x3F, 0x3F, 2, 0x1D, 0x2E,	// Ladder 2
+	0x4D, 0x5F, 0x5F, 1, 0x5E,	// Ladder 3
+	0x31, 0x53, 0x53, 1, 0x42,	// Ladder 4
+	// level29.txt
+	0x10, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x02,
+	0x00, 0xED, 0x09, 0xAA, 0x00, 0x9A, 0xAA, 0x00,
+	0x0C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80,
+	0x00, 0x0C, 0xEE, 0xD0, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0xCE, 0xD0,
+	0x00, 0x09, 0xAA, 0xAA, 0x00, 0x00, 0x00, 0x00,
+	0x0C, 0x00, 0x00, 0x00, 0x00, 0xEE, 0xED, 0x00,
+	0x00, 0xEE, 0xD0, 0x00, 0x0C, 0x00, 0x00, 0x00,
+	8,
+	0x48, 0x53, 0x53, 4, 0x57, 0x56, 0x55, 0x54,	// Snake 1
+	0x2E, 0x1A, 0x1A, 3, 0x1D, 0x1C, 0x1B,	// Snake 2
+	0x08, 0x15, 0x15, 2, 0x17, 0x16,	// Snake 3
+	0x79, 0x6D, 0x6D, 3, 0x6A, 0x6B, 0x6C,	// Ladder 1
+	0x21, 0x13, 0x13, 1, 0x12,	// Ladder 2
+	0x61, 0x74, 0x74, 2, 0x72, 0x73,	// Ladder 3
+	0x4C, 0x4E, 0x4E, 1, 0x4D,	// Ladder 4
+	0x33, 0x36, 0x36, 2, 0x34, 0x35,	// Ladder 5
+	// level30.txt
+	0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+	0x9A, 0xAA, 0xAA, 0xA0, 0x00, 0x08, 0x00, 0x0D,
+	0x00, 0x00, 0x00, 0x08, 0x00, 0xA0, 0x00, 0x0E,
+	0x00, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0xE0,
+	0x00, 0xEE, 0xD0, 0x9A, 0xA0, 0x00, 0x0C, 0x00,
+	0x0C, 0x00, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0xCE, 0xED, 0x00, 0xA0, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00,
+	6,
+	0x27, 0x10, 0x10, 6, 0x16, 0x15, 0x14, 0x13, 0x12, 0x11,	// Snake 1
+	0x7D, 0x5B, 0x5B, 1, 0x6C,	// Snake 2
+	0x1B, 0x46, 0x46, 4, 0x2A, 0x39, 0x48, 0x47,	// Snake 3
+	0x51, 0x44, 0x44, 2, 0x42, 0x43,	// Ladder 1
+	0x4D, 0x1F, 0x1F, 2, 0x3E, 0x2F,	// Ladder 2
+	0x66, 0x69, 0x69, 2, 0x67, 0x68,	// Ladder 3
+	// level31.txt
+	0x10, 0x00, 0x0C, 0xEE, 0xEE, 0xED, 0x00, 0x02,
+	0x0C, 0xED, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80,
+	0x00, 0x00, 0x00, 0x09, 0xAA, 0xAA, 0xAA, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x08, 0x00, 0x08, 0x00, 0x90, 0x00, 0x00,
+	0x00, 0xA0, 0x00, 0xA0, 0x00, 0x0A, 0x00, 0x00,
+	0x0A, 0x00, 0x0A, 0x00, 0x00, 0x00, 0xA0, 0x00,
+	0x09, 0x09, 0xA0, 0x00, 0xCE, 0xD0, 0x08, 0x00,
+	7,
+	0x1E, 0x27, 0x27, 6, 0x2D, 0x2C, 0x2B, 0x2A, 0x29, 0x28,	// Snake 1
+	0x7D, 0x4A, 0x4A, 2, 0x6C, 0x5B,	// Snake 2
+	0x43, 0x71, 0x71, 2, 0x52, 0x61,	// Snake 3
+	0x47, 0x73, 0x73, 3, 0x56, 0x65, 0x74,	// Snake 4
+	0x05, 0x0B, 0x0B, 5, 0x06, 0x07, 0x08, 0x09, 0x0A,	// Ladder 1
+	0x78, 0x7A, 0x7A, 1, 0x79,	// Ladder 2
+	0x11, 0x13, 0x13, 1, 0x12,	// Ladder 3
+	// level32.txt
+	0x10, 0x00, 0xED, 0x00, 0x00, 0x00, 0x00, 0x02,
+	0x00, 0x0C, 0x00, 0x00, 0x00, 0xEE, 0xED, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00,
+	0x90, 0x00, 0x09, 0xAA, 0xA8, 0x00, 0xA0, 0x00,
+	0xA0, 0x0C, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00,
+	0x0A, 0x00, 0xE0, 0x00, 0x00, 0x09, 0x00, 0x00,
+	0x00, 0x80, 0x0E, 0xEE, 0xD0, 0x00, 0x00, 0x00,
+	6,
+	0x3D, 0x6B, 0x6B, 2, 0x4C, 0x5B,	// Snake 1
+	0x72, 0x40, 0x40, 2, 0x61, 0x50,	// Snake 2
+	0x49, 0x45, 0x45, 3, 0x48, 0x47, 0x46,	// Snake 3
+	0x29, 0x1D, 0x1D, 3, 0x1A, 0x1B, 0x1C,	// Ladder 1
+	0x13, 0x05, 0x05, 1, 0x04,	// Ladder 2
+	0x53, 0x78, 0x78, 4, 0x64, 0x75, 0x76, 0x77,	// Ladder 3
+};
+
+// Offset of each level in level_pack
+static const uint16_t level_index[LEVEL_PACK_COUNT] PROGMEM = {
+	0,
+	109,
+	228,
+	336,
+	448,
+	553,
+	658,
+	773,
+	880,
+	994,
+	1095,
+	1209,
+	1322,
+	1428,
+	1531,
+	1633,
+	1748,
+	1857,
+	1965,
+	2082,
+	2191,
+	2304,
+	2422,
+	2525,
+	2636,
+	2741,
+	2842,
+	2958,
+	3073,
+	3188,
+	3294,
+	3407
+};
+
+// Fewest dice rolls needed to finish each level
+static const uint8_t level_min_rolls[LEVEL_PACK_COUNT] PROGMEM = {
+	14, 7, 15, 13, 14, 12, 17, 15, 11, 12, 9, 6, 12, 12, 15, 9, 16, 12, 14, 12, 10, 12, 15, 11, 14, 10, 12, 8, 12, 12, 12, 9
+};
+
+#endif /* LEVEL_PACK_H_ */
@@ -0,0 +1,174 @@
+/*
+ * levelgen.c
+ *
+ * Created: 17/10/2026 9:48:02 PM
+ *  Author: LiamM
+ *
+ * Seeded board generator. Each snake or ladder is drawn as a king-move line
+ * from a random start, and is only placed if none of its squares are taken
+ * and its start and end do not touch another start or end (or the start and
+ * finish squares). No end lands on another start, so jumps never chain, and
+ * no two snake starts are next to each other on the path, so every roll of
+ * six squares has somewhere to land and the finish is always reachable.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "levelgen.h"
+#include "gameboard.h"
+#include "game.h"
+
+// Attempts at placing each snake or ladder before giving up on it
+#define PLACE_ATTEMPTS		16
+// Rows a snake or ladder may span (start to end)
+#define MIN_LINK_RISE		2
+#define MAX_LINK_RISE		6
+// Columns a snake or ladder may lean by
+#define MAX_LINK_LEAN		2
+
+// Generator state, kept apart from the dice generator so the board depends
+// only on the seed.
+static uint16_t level_rand_state;
+
+// 16 bit XORshift, returns a number from 0 to max - 1. The range is scaled
+// with a multiply rather than a modulo, which needs a slow division on AVR.
+static uint8_t level_rand(uint8_t max) {
+	uint16_t x = level_rand_state;
+	
+	x ^= x << 7;
+	x ^= x >> 9;
+	x ^= x << 8;
+	level_rand_state = x;
+	
+	return ((x >> 8) * max) >> 8;
+}
+
+// Squares that are taken, and squares that are taken by or next to the start
+// or end of a snake or ladder, one bit per column (bit x) for each row.
+// Checking a candidate line is then a bit test per square. Both are the
+// scratch bitboards passed to generate_level(), so they take no RAM of their
+// own.
+static uint8_t* taken;
+static uint8_t* near_end;
+
+// Mark (x,y) as taken, and its neighbours as near an end if it is one.
+static void take_square(int8_t x, int8_t y, uint8_t is_end) {
+	taken[y] |= 1 << x;
+	
+	if (is_end) {
+		uint8_t bits = (uint8_t) ((0x07 << x) >> 1);
+		
+		for (int8_t ny = y - 1; ny <= y + 1; ny++) {
+			if (ny >= 0 && ny < HEIGHT) near_end[ny] |= bits;
+		}
+	}
+}
+
+// Step from (x,y) one king move towards (end_x,end_y).
+static void step_towards(int8_t* x, int8_t* y, int8_t end_x, int8_t end_y) {
+	*x += (end_x > *x) - (end_x < *x);
+	*y += (end_y > *y) - (end_y < *y);
+}
+
+// Try to place one snake (ladder 0) or ladder (ladder 1). Returns 1 if placed.
+static uint8_t place_link(level_data* level, uint8_t ladder) {
+	int8_t start_x = level_rand(WIDTH);
+	int8_t start_y;
+	int8_t rise = MIN_LINK_RISE + level_rand(MAX_LINK_RISE - MIN_LINK_RISE + 1);
+	int8_t end_x = start_x - MAX_LINK_LEAN + level_rand(2 * MAX_LINK_LEAN + 1);
+	int8_t end_y;
+	uint8_t length = 0;
+	
+	// Pick the start row so the end is always on the board.
+	if (ladder) {
+		start_y = level_rand(HEIGHT - rise);
+		end_y = start_y + rise;
+	}
+	else {
+		start_y = rise + level_rand(HEIGHT - rise);
+		end_y = start_y - rise;
+	}
+	
+	if (end_x < 0) end_x = 0;
+	if (end_x >= WIDTH) end_x = WIDTH - 1;
+	
+	int8_t x = start_x;
+	int8_t y = start_y;
+	
+	// Starts and ends may not touch each other, so they stay easy to tell
+	// apart and no two snake starts are next to each other on the path.
+	if ((near_end[start_y] & (1 << start_x)) || (near_end[end_y] & (1 << end_x))) return 0;
+	
+	// Check the whole line before drawing any of it.
+	while (1) {
+		if (taken[y] & (1 << x)) return 0;
+		if (x == end_x && y == end_y) break;
+		step_towards(&x, &y, end_x, end_y);
+		length++;
+	}
+	
+	// length counts the end square, the body is the squares in between.
+	length--;
+	if (length > MAX_LEVEL_BODY || level_body_used(level) + length > LEVEL_BODY_POOL_SIZE) return 0;
+	
+	level_add_link(level, PACK_SQUARE(start_x, start_y), PACK_SQUARE(end_x, end_y));
+	level_set_cell(level, start_x, start_y, ladder ? LADDER_START : SNAKE_START);
+	level_set_cell(level, end_x, end_y, ladder ? LADDER_END : SNAKE_END);
+	take_square(start_x, start_y, 1);
+	take_square(end_x, end_y, 1);
+	
+	x = start_x;
+	y = start_y;
+	for (uint8_t i = 0; i < length; i++) {
+		step_towards(&x, &y, end_x, end_y);
+		level_set_cell(level, x, y, ladder ? LADDER_MIDDLE : SNAKE_MIDDLE);
+		level_add_body_square(level, PACK_SQUARE(x, y));
+		take_square(x, y, 0);
+	}
+	
+	return 1;
+}
+
+// Build a board from a seed into level, in the upload buffer.
+void generate_level(uint16_t seed, uint8_t num_snakes, uint8_t num_ladders, level_data* level, bitboard* scratch) {
+	uint8_t ladder = 0;
+	
+	// XORshift never leaves 0, so avoid seeding it there.
+	level_rand_state = seed ^ 0xACE1;
+	if (level_rand_state == 0) level_rand_state = 1;
+	
+	taken = scratch[0];
+	near_end = scratch[1];
+	level_new(level);
+	memset(taken, 0, sizeof(bitboard));
+	memset(near_end, 0, sizeof(bitboard));
+	
+	level_set_cell(level, SQUARE_INDEX_X(0), SQUARE_INDEX_Y(0), START_POINT);
+	level_set_cell(level, SQUARE_INDEX_X(BOARD_SQUARES - 1), SQUARE_INDEX_Y(BOARD_SQUARES - 1), FINISH_LINE);
+	take_square(SQUARE_INDEX_X(0), SQUARE_INDEX_Y(0), 1);
+	take_square(SQUARE_INDEX_X(BOARD_SQUARES - 1), SQUARE_INDEX_Y(BOARD_SQUARES - 1), 1);
+	
+	// Alternate snakes and ladders so both get a fair share of the board.
+	while ((num_snakes > 0 || num_ladders > 0) && level->num_links < MAX_LEVEL_LINKS) {
+		if (num_snakes == 0) {
+			ladder = 1;
+		}
+		else if (num_ladders == 0) {
+			ladder = 0;
+		}
+		else {
+			ladder = 1 - ladder;
+		}
+		
+		for (uint8_t attempt = 0; attempt < PLACE_ATTEMPTS; attempt++) {
+			if (place_link(level, ladder)) break;
+		}
+		
+		if (ladder) {
+			num_ladders--;
+		}
+		else {
+			num_snakes--;
+		}
+	}
+}
@@ -0,0 +1,24 @@
+/*
+ * levelgen.h
+ *
+ * Created: 17/10/2026 9:48:20 PM
+ *  Author: LiamM
+ */
+
+
+#ifndef LEVELGEN_H_
+#define LEVELGEN_H_
+
+#include <stdint.h>
+#include "gameboard.h"
+
+// Default number of snakes and ladders on a generated board
+#define GENERATED_SNAKES	5
+#define GENERATED_LADDERS	5
+
+// Build a board from a seed into level. The same seed and counts always give
+// the same board. Fewer links than asked for are placed if the board fills up.
+// scratch is two bitboards the generator may use while it runs.
+void generate_level(uint16_t seed, uint8_t num_snakes, uint8_t num_ladders, level_data* level, bitboard* scratch);
+
+#endif /* LEVELGEN_H_ */
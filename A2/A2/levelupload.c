@@ -0,0 +1,302 @@
+/*
+ * levelupload.c
+ *
+ * Created: 17/10/2026 10:32:09 PM
+ *  Author: LiamM
+ *
+ * Frames are parsed a byte at a time in the serial receive interrupt, and
+ * chunks are copied straight into a RAM image of the level, so the main loop
+ * only has to send the replies. Writing an EEPROM byte takes about 3.4 ms,
+ * far slower than the line, so the level is only written once it has been
+ * received in full, one byte per call of upload_poll() so the game keeps
+ * running. The slot length is cleared first and written last, so a slot left
+ * half written (e.g. by a reset) reads as empty.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <avr/eeprom.h>
+#include <util/atomic.h>
+#include <util/crc16.h>
+#include "levelupload.h"
+#include "gameboard.h"
+
+// Give up on a frame if no more of it arrives for this long (ms), so a host
+// that stops mid frame does not swallow the game's keyboard input.
+#define UPLOAD_FRAME_TIMEOUT	200
+
+// Receive states, the field expected next
+#define RX_IDLE		0
+#define RX_SLOT		1
+#define RX_SEQ		2
+#define RX_LEN		3
+#define RX_PAYLOAD	4
+#define RX_CRC_LOW	5
+#define RX_CRC_HIGH	6
+
+// Replies waiting to be sent by upload_poll()
+#define REPLY_QUEUE_SIZE	4
+
+// Each slot is the level length (little endian) followed by the level. Erased
+// EEPROM reads 0xFFFF, which is longer than any level, so unused slots are empty.
+static uint8_t EEMEM upload_slots[UPLOAD_SLOTS][UPLOAD_SLOT_SIZE];
+
+// The level being received. Only the receive interrupt writes to it, until
+// upload_ready is set, and then only upload_poll() uses it until it is cleared.
+// While buffer_claimed is set it holds the game board instead.
+static uint8_t image[LEVEL_MAX_BYTES];
+static uint8_t buffer_claimed;
+static uint16_t image_length;
+static uint8_t upload_slot = 0xFF;
+static uint8_t expected_seq;
+static volatile uint8_t upload_ready;
+static uint8_t image_damaged;	// A bad frame wrote over an acknowledged chunk
+
+// Frame being received, only used by the receive interrupt (apart from
+// upload_poll() resetting rx_state after a timeout).
+static volatile uint8_t rx_state = RX_IDLE;
+static volatile uint8_t rx_bytes;	// Counts frame bytes, for the timeout
+static uint8_t rx_slot;
+static uint8_t rx_seq;
+static uint8_t rx_len;
+static uint8_t rx_count;
+static uint8_t rx_store;	// Payload goes into image at rx_offset
+static uint16_t rx_offset;
+static uint16_t rx_crc;
+static uint8_t rx_crc_low;
+
+// Replies, written by the receive interrupt and sent by upload_poll(). The
+// reply to the last chunk is sent by upload_poll() itself.
+static uint8_t reply_type[REPLY_QUEUE_SIZE];
+static uint8_t reply_seq[REPLY_QUEUE_SIZE];
+static volatile uint8_t reply_head;
+static volatile uint8_t reply_tail;
+
+// Progress writing the received level to EEPROM, COMMIT_IDLE when not writing.
+// Step 0 clears the slot length, steps 1 to image_length write the level and
+// the last step writes the length.
+#define COMMIT_IDLE	0xFFFF
+static uint16_t commit_step = COMMIT_IDLE;
+
+static uint8_t seen_rx_bytes;
+static uint32_t last_rx_time;
+
+// Queue a reply. If the queue is full the reply is lost and the host will
+// time out and send the frame again.
+static void queue_reply(uint8_t type, uint8_t seq) {
+	uint8_t tail = reply_tail;
+	uint8_t next = (tail + 1) % REPLY_QUEUE_SIZE;
+	
+	if (next == reply_head) return;
+	
+	reply_type[tail] = type;
+	reply_seq[tail] = seq;
+	reply_tail = next;
+}
+
+// Act on a frame once its CRC has been checked.
+static void frame_received(uint8_t crc_ok) {
+	if (!crc_ok) {
+		// The header may be wrong too, so the upload carries on as it was.
+		// The payload was only stored over the chunk expected next, which
+		// is sent again, or over the first chunk if it claimed to start a
+		// new upload. The level is then rejected when it is complete.
+		if (rx_store && rx_seq != expected_seq) image_damaged = 1;
+		queue_reply(UPLOAD_NAK, rx_seq);
+	}
+	else if (rx_store) {
+		if (rx_seq == 0) image_damaged = 0;
+		upload_slot = rx_slot;
+		expected_seq = rx_seq + 1;
+		
+		if (rx_len < UPLOAD_CHUNK_SIZE) {
+			// Last chunk, acknowledged once it is in EEPROM
+			image_length = rx_offset + rx_len;
+			upload_ready = 1;
+		}
+		else {
+			queue_reply(UPLOAD_ACK, rx_seq);
+		}
+	}
+	else if (!upload_ready && rx_slot == upload_slot && rx_seq < expected_seq) {
+		// The host missed an acknowledgement and sent an earlier chunk again.
+		// The host may have several chunks in flight, so this need not be the
+		// last chunk received.
+		queue_reply(UPLOAD_ACK, rx_seq);
+	}
+	else {
+		queue_reply(UPLOAD_NAK, rx_seq);
+	}
+}
+
+uint8_t upload_receive_byte(uint8_t c) {
+	uint8_t state = rx_state;
+	
+	if (state == RX_IDLE) {
+		if (c != UPLOAD_SOH) return 0;
+		
+		rx_crc = 0xFFFF;
+		rx_state = RX_SLOT;
+		rx_bytes++;
+		return 1;
+	}
+	
+	rx_bytes++;
+	if (state < RX_CRC_LOW) {
+		rx_crc = _crc_ccitt_update(rx_crc, c);
+	}
+	
+	switch (state) {
+		case RX_SLOT:
+			rx_slot = c;
+			rx_state = RX_SEQ;
+			break;
+		case RX_SEQ:
+			rx_seq = c;
+			rx_state = RX_LEN;
+			break;
+		case RX_LEN:
+			if (c > UPLOAD_CHUNK_SIZE) {
+				// Not a frame we could have been sent, wait for the next SOH.
+				rx_state = RX_IDLE;
+				break;
+			}
+			rx_len = c;
+			rx_count = 0;
+			rx_offset = (uint16_t) rx_seq * UPLOAD_CHUNK_SIZE;
+			// Only keep the payload of the chunk expected next (or the first
+			// chunk of a new upload), once the last level has been written
+			// and while the buffer is not holding the game board.
+			rx_store = !upload_ready && !buffer_claimed && rx_slot < UPLOAD_SLOTS
+					&& (rx_seq == 0 || (rx_slot == upload_slot && rx_seq == expected_seq))
+					&& rx_seq < (LEVEL_MAX_BYTES + UPLOAD_CHUNK_SIZE - 1) / UPLOAD_CHUNK_SIZE
+					&& rx_offset + rx_len <= LEVEL_MAX_BYTES;
+			rx_state = (rx_len > 0) ? RX_PAYLOAD : RX_CRC_LOW;
+			break;
+		case RX_PAYLOAD:
+			if (rx_store) {
+				image[rx_offset + rx_count] = c;
+			}
+			if (++rx_count == rx_len) {
+				rx_state = RX_CRC_LOW;
+			}
+			break;
+		case RX_CRC_LOW:
+			rx_crc_low = c;
+			rx_state = RX_CRC_HIGH;
+			break;
+		default:
+			rx_state = RX_IDLE;
+			frame_received(rx_crc == (rx_crc_low | ((uint16_t) c << 8)));
+			break;
+	}
+	return 1;
+}
+
+// Write the next byte of the received level to EEPROM if the EEPROM is free.
+static void commit_next(void) {
+	uint8_t* slot = upload_slots[upload_slot];
+	
+	if (!eeprom_is_ready()) return;
+	
+	if (commit_step == 0) {
+		eeprom_update_word((uint16_t*) slot, 0);
+	}
+	else if (commit_step <= image_length) {
+		eeprom_update_byte(slot + 1 + commit_step, image[commit_step - 1]);
+	}
+	else {
+		eeprom_update_word((uint16_t*) slot, image_length);
+		commit_step = COMMIT_IDLE;
+		putchar(UPLOAD_ACK);
+		putchar(expected_seq - 1);
+		upload_ready = 0;
+		return;
+	}
+	commit_step++;
+}
+
+// Check the received level, then write the next byte of it to EEPROM.
+static void commit_upload(void) {
+	if (commit_step == COMMIT_IDLE) {
+		// Check the level before overwriting what is in the slot
+		if (image_damaged || !check_level_image(image, image_length)) {
+			putchar(UPLOAD_NAK);
+			putchar(expected_seq - 1);
+			// Make the host start again from the first chunk
+			ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+				expected_seq = 0;
+				upload_ready = 0;
+			}
+			return;
+		}
+		commit_step = 0;
+	}
+	commit_next();
+}
+
+void upload_poll(uint32_t current_time) {
+	// Send any replies
+	while (reply_head != reply_tail) {
+		uint8_t head = reply_head;
+		
+		putchar(reply_type[head]);
+		putchar(reply_seq[head]);
+		reply_head = (head + 1) % REPLY_QUEUE_SIZE;
+	}
+	
+	// Drop a frame that has stopped arriving
+	if (rx_bytes != seen_rx_bytes) {
+		seen_rx_bytes = rx_bytes;
+		last_rx_time = current_time;
+	}
+	else if (rx_state != RX_IDLE && current_time - last_rx_time > UPLOAD_FRAME_TIMEOUT) {
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+			if (rx_bytes == seen_rx_bytes) rx_state = RX_IDLE;
+		}
+	}
+	
+	if (upload_ready) commit_upload();
+}
+
+uint16_t upload_slot_length(uint8_t slot) {
+	if (slot >= UPLOAD_SLOTS) return 0;
+	
+	uint16_t length = eeprom_read_word((const uint16_t*) upload_slots[slot]);
+	
+	return (length > LEVEL_MAX_BYTES) ? 0 : length;
+}
+
+const uint8_t* upload_slot_image(uint8_t slot) {
+	return upload_slots[slot] + 2;
+}
+
+uint8_t* upload_claim_buffer(void) {
+	// Finish writing a level that has been received in full
+	while (upload_ready) {
+		commit_upload();
+	}
+	
+	// Drop any upload under way, the host has to start it again
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+		buffer_claimed = 1;
+		rx_store = 0;
+		upload_slot = 0xFF;
+	}
+	return image;
+}
+
+void upload_release_buffer(void) {
+	buffer_claimed = 0;
+}
+
+uint8_t store_level_slot(uint8_t slot, const level_data* level) {
+	if (slot >= UPLOAD_SLOTS || (upload_ready && upload_slot == slot)) return 0;
+	
+	// As with an upload, the slot reads as empty until the length is written.
+	eeprom_update_word((uint16_t*) upload_slots[slot], 0);
+	eeprom_update_block(level->packed, upload_slots[slot] + 2, level->length);
+	eeprom_update_word((uint16_t*) upload_slots[slot], level->length);
+	
+	return 1;
+}
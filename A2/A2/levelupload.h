@@ -0,0 +1,65 @@
+/*
+ * levelupload.h
+ *
+ * Created: 17/10/2026 10:31:44 PM
+ *  Author: LiamM
+ */
+
+
+#ifndef LEVELUPLOAD_H_
+#define LEVELUPLOAD_H_
+
+#include <stdint.h>
+#include "gameboard.h"
+
+// Packed levels (in the level pack format, see gameboard.h) can be pushed
+// over the serial port into EEPROM slots, without reflashing. The host
+// sends the level in frames of:
+//   SOH, slot, seq, len, payload (len bytes), CRC low byte, CRC high byte
+// with the CRC taken over slot, seq, len and the payload by _crc_ccitt_update()
+// starting from 0xFFFF. seq 0 starts an upload into a slot and later chunks
+// follow in order. Every chunk holds UPLOAD_CHUNK_SIZE bytes of the level
+// except the last, which is shorter (possibly empty) and ends the upload.
+// Each frame is answered with ACK or NAK followed by its seq. The last chunk
+// is only acknowledged once the level has been checked and written to EEPROM,
+// earlier chunks as soon as they are received, so the host may send the next
+// chunk before the previous one is acknowledged. A NAK asks for the frame to
+// be sent again (or the upload restarted from seq 0 if the level was bad).
+// levelc -b writes a level in the format to be uploaded.
+#define UPLOAD_SOH			0x01
+#define UPLOAD_ACK			0x06
+#define UPLOAD_NAK			0x15
+#define UPLOAD_CHUNK_SIZE	32
+
+// Slots hold a two byte length and then the level. They share 768 bytes of
+// EEPROM, so there are four of them for 16 row boards but fewer for taller ones.
+#define UPLOAD_SLOT_SIZE	(2 + LEVEL_MAX_BYTES)
+#define UPLOAD_SLOTS		(768 / UPLOAD_SLOT_SIZE)
+
+// Called by the serial receive interrupt with each byte received. Returns 1
+// if the byte was part of an upload frame, 0 if it is ordinary input.
+uint8_t upload_receive_byte(uint8_t c);
+
+// Send replies and write a received level to EEPROM. Called from the main
+// loop, never blocks.
+void upload_poll(uint32_t current_time);
+
+// Return the length of the level stored in a slot, or 0 if the slot is empty.
+uint16_t upload_slot_length(uint8_t slot);
+
+// Return the EEPROM address of the level stored in a slot.
+const uint8_t* upload_slot_image(uint8_t slot);
+
+// The RAM buffer uploads are received into also holds the game board when it
+// is not read from the level pack (see level_data). upload_claim_buffer()
+// finishes writing any level received in full, drops any upload under way and
+// returns the buffer. Uploads are refused with NAK until it is released.
+uint8_t* upload_claim_buffer(void);
+
+void upload_release_buffer(void);
+
+// Write a level held in RAM into a slot straight away (blocking, as with a
+// snapshot). Returns 0 if the slot is being written by an upload.
+uint8_t store_level_slot(uint8_t slot, const level_data* level);
+
+#endif /* LEVELUPLOAD_H_ */
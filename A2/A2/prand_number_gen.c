@@ -25,4 +25,9 @@ uint8_t p_rand_next(uint8_t max) {
 	state = x;
 
 	return x % max;
+}
+
+// Return the current generator state (restore it with p_rand_seed()).
+uint8_t p_rand_state(void) {
+	return state;
 }
\ No newline at end of file
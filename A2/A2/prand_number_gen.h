@@ -17,4 +17,7 @@ void p_rand_seed(uint32_t num);
 // Set up p_rand generator function.
 uint8_t p_rand_next(uint8_t max);
 
+// Return the current generator state (restore it with p_rand_seed()).
+uint8_t p_rand_state(void);
+
 #endif
\ No newline at end of file
@@ -29,46 +29,133 @@
 #include "joystick.h"
 #include "buzzer.h"
 #include "animator.h"
+#include "snapshot.h"
+#include "levelgen.h"
+#include "levelupload.h"
+#include "editor.h"
+
+// Top level states. The main loop ticks the current state once per
+// iteration with the sampled inputs, and the tick returns the next state.
+#define STATE_SPLASH	0
+#define STATE_SETUP		1
+#define STATE_PLAYING	2
+#define STATE_PAUSED	3
+#define STATE_GAME_OVER	4
+#define STATE_EDITOR	5
+#define NUM_STATES		6
+
+typedef struct {
+	// Run once when the state is entered (may be NULL).
+	void (*enter)(void);
+	// Run every main loop iteration, returns the next state.
+	uint8_t (*tick)(char serial_input, int8_t btn, uint32_t current_time);
+} state_handler;
 
 // Function prototypes - these are defined below (after main()) in the order
 // given here
 void initialise_hardware(void);
 void start_screen(void);
+uint8_t start_screen_tick(char serial_input, int8_t btn, uint32_t current_time);
 void new_game(void);
-void play_game(void);
+uint8_t new_game_tick(char serial_input, int8_t btn, uint32_t current_time);
+void start_play(uint32_t current_time);
+uint8_t play_game_tick(char serial_input, int8_t btn, uint32_t current_time);
+void pause_game(void);
+uint8_t paused_tick(char serial_input, int8_t btn, uint32_t current_time);
 void handle_game_over(void);
+uint8_t game_over_tick(char serial_input, int8_t btn, uint32_t current_time);
+void start_editor(void);
+uint8_t editor_tick(char serial_input, int8_t btn, uint32_t current_time);
 void print_new_game(void);
 void print_multi_player(void);
 void print_start_game(void);
 void print_game_over(void);
+void print_level(uint8_t game_board_num);
 void print_difficulty(void);
 void print_difficulty_time(uint16_t player_time);
 void print_paused(uint8_t paused);
+void print_editor(void);
+void print_edit_result(uint8_t result);
 uint8_t handle_serial_input(char serial_input, uint8_t player_num);
 uint8_t handle_button_input(uint8_t btn, uint8_t player_num);
-uint8_t handle_restart_wait(char serial_input);
+uint8_t handle_restart_wait(char serial_input, int8_t btn);
 uint8_t handle_multi_player_input(char serial_input);
 uint8_t handle_difficulty_input(char serial_input);
 uint8_t handle_board_change_input(char serial_input);
+uint8_t handle_generated_board_input(char serial_input);
 uint8_t handle_audio_input(char serial_input);
 uint8_t handle_pause_input(char serial_input, uint8_t btn);
+uint8_t handle_snapshot_input(char serial_input);
+uint8_t handle_undo_input(char serial_input);
 uint8_t handle_joysick_input(int8_t *dx, int8_t *dy, uint8_t player_num);
 
+static const state_handler state_table[NUM_STATES] = {
+	[STATE_SPLASH]		= {start_screen, start_screen_tick},
+	[STATE_SETUP]		= {new_game, new_game_tick},
+	// Play is started by start_play() from setup so resuming from a pause
+	// keeps the game timers.
+	[STATE_PLAYING]		= {NULL, play_game_tick},
+	[STATE_PAUSED]		= {pause_game, paused_tick},
+	[STATE_GAME_OVER]	= {handle_game_over, game_over_tick},
+	[STATE_EDITOR]		= {start_editor, editor_tick},
+};
+
+// Board selected when the setup screen is next shown (only accessed locally)
+uint8_t next_game_board = GAMEBOARD_1;
+
+// Seed typed in for a generated board (only accessed locally)
+uint8_t seed_entry_flag;
+uint16_t entered_seed;
+
+// Set while waiting for a slot to replace after a save found them all full
+// (only accessed locally)
+uint8_t replace_slot_flag;
+
+// Game play timers and values (only accessed locally)
+uint32_t last_flash_time;
+uint32_t last_view_time;
+uint32_t last_dice_time;
+uint32_t last_difficulty_time;
+uint32_t pause_start_time;
+uint32_t joystick_time;
+uint16_t joystick_delay;
+uint8_t dice_num;
+int8_t current_player_dx;
+int8_t current_player_dy;
+
 /////////////////////////////// main //////////////////////////////////
 int main(void) {
+	uint8_t state = STATE_SPLASH;
+	uint8_t next_state;
+	
 	// Setup hardware and call backs. This will turn on 
 	// interrupts.
 	initialise_hardware();
 	
-	// Show the splash screen message. Returns when display
-	// is complete.
-	start_screen();
+	// Show the splash screen message.
+	state_table[state].enter();
 	
-	// Loop forever and continuously play the game.
+	// Loop forever, sampling the inputs and ticking the current state.
 	while(1) {
-		new_game();
-		play_game();
-		handle_game_over();
+		// Check if any button has been pushed
+		int8_t btn = button_pushed();
+		// Read serial input from terminal
+		char serial_input = get_serial();
+		// Set current time in ms
+		uint32_t current_time = get_current_time();
+		
+		next_state = state_table[state].tick(serial_input, btn, current_time);
+		
+		// Send the LED matrix cells drawn since the last time round
+		ledmatrix_flush();
+		
+		// Reply to and store any level being uploaded over serial
+		upload_poll(current_time);
+		
+		if (next_state != state) {
+			state = next_state;
+			if (state_table[state].enter) state_table[state].enter();
+		}
 	}
 }
 
@@ -102,17 +189,18 @@ void start_screen(void) {
 	// Output the static start screen
 	start_display();
 	play_melody(start_sound, 38);
+}
+
+// Wait until a button is pressed, or 's' is pressed on the terminal
+uint8_t start_screen_tick(char serial_input, int8_t btn, uint32_t current_time) {
+	if (!handle_restart_wait(serial_input, btn)) return STATE_SETUP;
 	
-	// Wait until a button is pressed, or 's' is pressed on the terminal
-	char serial_input = get_serial();
-	while(handle_restart_wait(serial_input)) {
-		serial_input = get_serial();
-		
-		// Handle audio output change
-		if (handle_audio_input(serial_input)) {
-			set_game_mute_flag(get_mute_tone());
-		}
+	// Handle audio output change
+	if (handle_audio_input(serial_input)) {
+		set_game_mute_flag(get_mute_tone());
 	}
+	
+	return STATE_SPLASH;
 }
 
 void new_game(void) {
@@ -122,212 +210,344 @@ void new_game(void) {
 	print_new_game();
 	print_multi_player();
 	
-	//Set game board to default level.
-	init_game_board(GAMEBOARD_1);
+	// Set game board to default level, or the board just left in the editor.
+	seed_entry_flag = 0;
+	init_game_board(next_game_board);
 	
-	move_terminal_cursor(10,12);
-	printf("Level: %d", GAMEBOARD_1);
-
-	print_difficulty();
+	print_level(next_game_board);
+	next_game_board = GAMEBOARD_1;
 	
-	char serial_input = get_serial();
+	print_difficulty();
+}
+
+// Handle the game options until the game is started
+uint8_t new_game_tick(char serial_input, int8_t btn, uint32_t current_time) {
+	// A seed being typed in takes all serial input until it is finished.
+	if (handle_generated_board_input(serial_input) || seed_entry_flag) {
+		return STATE_SETUP;
+	}
 	
-	while(handle_restart_wait(serial_input)) {
-		serial_input = get_serial();
+	if (!handle_restart_wait(serial_input, btn)) {
+		print_start_game();
 		
-		handle_board_change_input(serial_input);
+		// Initialise the game and display
+		init_game();
 		
-		// Handle audio output change
-		if (handle_audio_input(serial_input)) {
-			set_game_mute_flag(get_mute_tone());
-		}
+		// Clear a button push or serial input if any are waiting
+		// (The cast to void means the return value is ignored.)
+		(void) button_pushed();
+		clear_serial_input_buffer();
 		
-		// Handle multiplayer select
-		if (handle_multi_player_input(serial_input)) {
-			print_multi_player();
-		}
-		
-		// Handle difficulty select
-		if (handle_difficulty_input(serial_input)) {
-			print_difficulty();
-		}
+		start_play(current_time);
+		return STATE_PLAYING;
+	}
+	
+	handle_board_change_input(serial_input);
+	
+	// Edit the selected board
+	if (serial_input == 'c' || serial_input == 'C') {
+		play_sound(button_sound);
+		return STATE_EDITOR;
 	}
 	
-	print_start_game();
+	// Handle audio output change
+	if (handle_audio_input(serial_input)) {
+		set_game_mute_flag(get_mute_tone());
+	}
 	
-	// Initialise the game and display
-	init_game();
+	// Handle multiplayer select
+	if (handle_multi_player_input(serial_input)) {
+		print_multi_player();
+	}
 	
-	// Clear a button push or serial input if any are waiting
-	// (The cast to void means the return value is ignored.)
-	(void) button_pushed();
-	clear_serial_input_buffer();
+	// Handle difficulty select
+	if (handle_difficulty_input(serial_input)) {
+		print_difficulty();
+	}
+	
+	return STATE_SETUP;
 }
 
-void play_game(void) {
-	// Create local game variables and timers
-	uint32_t last_flash_time, last_dice_time, last_difficulty_time, pause_start_time, pause_delta_time, joystick_time, current_time;
-	uint16_t joystick_delay = 0;
-	uint8_t button_input;
-	uint8_t dice_num = 0;
-	uint8_t pause_flag = 0;
-	uint8_t current_player_num = PLAYER_1;	
-	int8_t current_player_dx = 0;
-	int8_t current_player_dy = 0;
-	char serial_input;
-	
+// Reset the game play timers at the start of a game
+void start_play(uint32_t current_time) {
+	joystick_delay = 0;
+	dice_num = 0;
+	current_player_dx = 0;
+	current_player_dy = 0;
 	pause_start_time = 0;
-	pause_delta_time = 0;
 	
-	last_flash_time = get_current_time();
-	last_dice_time = get_current_time();
-	last_difficulty_time = get_current_time();
-	joystick_time = get_current_time();
+	last_flash_time = current_time;
+	last_view_time = current_time;
+	last_dice_time = current_time;
+	last_difficulty_time = current_time;
+	joystick_time = current_time;
+}
+
+// Run one iteration of the game until game over is triggered
+uint8_t play_game_tick(char serial_input, int8_t btn, uint32_t current_time) {
+	// The player whose turn it is (restoring a saved game may change it)
+	uint8_t current_player_num = get_active_player();
+	
+	// Handle game pause conditions
+	if (handle_pause_input(serial_input, btn)) {
+		pause_start_time = current_time;
+		return STATE_PAUSED;
+	}
 	
-	// Loop game until game over is triggered
-	while(!is_game_over()) {
-		// Check if any button has been pushed
-		button_input = button_pushed();
-		// Read serial input from terminal
-		serial_input = get_serial();
-		// Set current time in ms
-		current_time = get_current_time();
+	sevenseg_display_digit(get_player_turns() % 10, dice_num);
+	
+	// Handle audio output change
+	if (handle_audio_input(serial_input)) {
+		set_game_mute_flag(get_mute_tone());
+	}
+	
+	// Handle difficulty change
+	if (handle_difficulty_input(serial_input)) {
+		print_difficulty();
+	}
+	
+	// Handle saving and restoring the game
+	if (handle_snapshot_input(serial_input)) {
+		print_difficulty();
+		current_player_num = get_active_player();
+		last_flash_time = current_time;
+	}
+	
+	// Handle undoing the last move
+	if (handle_undo_input(serial_input)) {
+		current_player_num = get_active_player();
+		last_flash_time = current_time;
+	}
+	
+	// Handle joystick movement
+	if (current_time >= joystick_time + joystick_delay) {
+		joystick_delay = 0;
 		
-		// Handle game pause conditions
-		if (handle_pause_input(serial_input, button_input)) {
-			pause_flag = 1 - pause_flag;
-			print_paused(pause_flag);
+		if (handle_joysick_input(&current_player_dx, &current_player_dy, current_player_num)) {
+			set_player_visibility(1, current_player_num);
 			
-			if (pause_flag) {
-				pause_start_time = current_time;
-				set_mute_tone(1);
-				pause_animations(1);
-			}
-			else {
-				pause_delta_time = current_time - pause_start_time;
-				set_mute_tone(get_game_mute_flag());
-				pause_animations(0);
+			if (!get_single_player()) {
+				current_player_num = next_active_player();
+				joystick_delay = 800;
+				set_axis_hold(0);
 			}
+			last_flash_time = current_time;
 		}
+		joystick_time = current_time;
+	}
+	
+	// Handle IO board button input
+	if (handle_button_input(btn, current_player_num)) {
+		set_player_visibility(1, current_player_num);
+		current_player_num = next_active_player();
+		last_flash_time = current_time;
+	}
+	
+	// Handle serial terminal input
+	if (handle_serial_input(serial_input, current_player_num)) {
+		set_player_visibility(1, current_player_num);
+		last_flash_time = current_time;
+	}
+	
+	// When the dice roll finishes generate random number and print to terminal 
+	if (get_dice_roll_finish()) {
+		dice_num = dice_roll_rand();
 		
-		if (!pause_flag) {
-			sevenseg_display_digit(get_player_turns() % 10, dice_num);
-			
-			// Handle audio output change
-			if (handle_audio_input(serial_input)) {
-				set_game_mute_flag(get_mute_tone());
-			}
-			
-			// Handle difficulty change
-			if (handle_difficulty_input(serial_input)) {
-				print_difficulty();
-			}
-			
-			// Handle joystick movement
-			if (current_time >= joystick_time + joystick_delay) {
-				joystick_delay = 0;
-				
-				if (handle_joysick_input(&current_player_dx, &current_player_dy, current_player_num)) {
-					set_player_visibility(1, current_player_num);
-					
-					if (!get_single_player()) {
-						current_player_num = handle_player_num_change(current_player_num);
-						joystick_delay = 800;
-						set_axis_hold(0);
-					}
-					last_flash_time = current_time;
-					last_difficulty_time = current_time;
-				}
-				joystick_time = current_time;
-			}
-		
-			// Handle IO board button input
-			if (handle_button_input(button_input, current_player_num)) {
-				set_player_visibility(1, current_player_num);
-				if (!get_single_player()) current_player_num = handle_player_num_change(current_player_num);
-				last_flash_time = current_time;
-				last_difficulty_time = current_time;
-			}
-			
-			// Handle serial terminal input
-			if (handle_serial_input(serial_input, current_player_num)) {
-				set_player_visibility(1, current_player_num);
-				last_flash_time = current_time;
-				last_difficulty_time = current_time;
-			}
-			
-			// When the dice roll finishes generate random number and print to terminal 
-			if (get_dice_roll_finish()) {
-				dice_num = dice_roll_rand();
-			
-				move_terminal_cursor(10,13);
-				printf("Dice Number: %d", dice_num);
-			
-				move_player_n(dice_num, current_player_num);
-				set_player_visibility(1, current_player_num);
-			
-				if (!get_single_player()) current_player_num = handle_player_num_change(current_player_num);
-				last_flash_time = current_time;
-				last_difficulty_time = current_time;
-			}
-		
-			// Decrement difficulty timer every 10ms
-			if (current_time >= last_difficulty_time + 10 && get_game_difficulty() != EASY)  {
-				print_difficulty_time(update_player_time(current_player_num));
-				last_difficulty_time = current_time;
-			}
+		move_terminal_cursor(10,13);
+		printf_P(PSTR("Dice Number: %d"), dice_num);
 		
-			// Change dice roll every 80ms
-			if (current_time >= last_dice_time + 80) {
-				if (get_dice_rolling()) {
-					dice_num = dice_roll();
-				
-					move_terminal_cursor(10,13);
-					printf("Dice Number: %d", dice_num);
-				}
-				last_dice_time = current_time;
-			}
+		move_player_n(dice_num, current_player_num);
+		set_player_visibility(1, current_player_num);
 		
-			// Flash player
-			if (current_time >= last_flash_time + pause_delta_time + 500) {
-				flash_player_cursor(current_player_num);
-				pause_delta_time = 0;
-				last_flash_time = current_time;
-			}
+		current_player_num = next_active_player();
+		last_flash_time = current_time;
+	}
+	
+	// Refresh the difficulty timer display every 10ms. The time itself
+	// comes from the hardware clock so a slow iteration loses nothing.
+	if (current_time >= last_difficulty_time + 10 && get_game_difficulty() != EASY)  {
+		print_difficulty_time(update_player_time(current_player_num));
+		last_difficulty_time = current_time;
+	}
+	
+	// Change dice roll every 80ms
+	if (current_time >= last_dice_time + 80) {
+		if (get_dice_rolling()) {
+			dice_num = dice_roll();
+			
+			move_terminal_cursor(10,13);
+			printf_P(PSTR("Dice Number: %d"), dice_num);
 		}
+		last_dice_time = current_time;
 	}
+	
+	// Flash player
+	if (current_time >= last_flash_time + 500) {
+		flash_player_cursor(current_player_num);
+		last_flash_time = current_time;
+	}
+	
+	// Scroll a tall board a row every 50ms to keep up with the players
+	if (current_time >= last_view_time + 50) {
+		follow_players();
+		last_view_time = current_time;
+	}
+	
+	return is_game_over() ? STATE_GAME_OVER : STATE_PLAYING;
 }
 
-// Handle game over game loop
-void handle_game_over() {
+// Freeze the game timers, sound and animations
+void pause_game(void) {
+	print_paused(1);
+	pause_player_timer(1);
+	set_mute_tone(1);
+	pause_animations(1);
+}
+
+// Wait for the game to be resumed
+uint8_t paused_tick(char serial_input, int8_t btn, uint32_t current_time) {
+	if (!handle_pause_input(serial_input, btn)) return STATE_PAUSED;
+	
+	print_paused(0);
+	
+	// Resume the flash cycle where the pause interrupted it.
+	last_flash_time += current_time - pause_start_time;
+	pause_player_timer(0);
+	set_mute_tone(get_game_mute_flag());
+	pause_animations(0);
+	
+	return STATE_PLAYING;
+}
+
+// Show the game over screen
+void handle_game_over(void) {
 	play_melody(gameover_sound, 17);
 	play_game_over_anim();
 	print_game_over();
+}
 
-	char serial_input = get_serial();
+// Wait for a new game to be started
+uint8_t game_over_tick(char serial_input, int8_t btn, uint32_t current_time) {
+	if (!handle_restart_wait(serial_input, btn)) {
+		stop_animations();
+		return STATE_SETUP;
+	}
+	
+	// Handle audio output change
+	if (handle_audio_input(serial_input)) {
+		set_game_mute_flag(get_mute_tone());
+	}
 	
-	while(handle_restart_wait(serial_input)) {
-		serial_input = get_serial();
+	return STATE_GAME_OVER;
+}
+
+// Start editing the selected board
+void start_editor(void) {
+	print_editor();
+	editor_start();
+	
+	current_player_dx = 0;
+	current_player_dy = 0;
+	last_flash_time = get_current_time();
+	replace_slot_flag = 0;
+}
+
+// Handle the editor keys until the board is saved or the editor is left.
+// Each change only redraws the squares it affects.
+uint8_t editor_tick(char serial_input, int8_t btn, uint32_t current_time) {
+	uint8_t result = EDIT_NOTHING;
+	uint8_t acted = 1;
+	uint8_t save_slot = EDITOR_ANY_SLOT;
+	
+	// After a save found every slot full, a slot number saves over that slot
+	// and any other key or button carries on editing.
+	if (replace_slot_flag && (serial_input != -1 || btn != NO_BUTTON_PUSHED)) {
+		replace_slot_flag = 0;
+		print_edit_result(EDIT_OK);
+		if (serial_input >= '1' && serial_input < '1' + UPLOAD_SLOTS) {
+			save_slot = serial_input - '1';
+			serial_input = '\r';
+		}
+	}
+	
+	if (serial_input == 'w' || serial_input == 'W') {
+		editor_move_cursor(0, 1);
+	}
+	else if (serial_input == 'a' || serial_input == 'A') {
+		editor_move_cursor(-1, 0);
+	}
+	else if (serial_input == 's' || serial_input == 'S') {
+		editor_move_cursor(0, -1);
+	}
+	else if (serial_input == 'd' || serial_input == 'D') {
+		editor_move_cursor(1, 0);
+	}
+	else if (serial_input == 'n' || serial_input == 'N' || btn == BUTTON0_PUSHED) {
+		result = editor_place(0);
+		print_edit_result(result);
+	}
+	else if (serial_input == 'l' || serial_input == 'L' || btn == BUTTON1_PUSHED) {
+		result = editor_place(1);
+		print_edit_result(result);
+	}
+	else if (serial_input == 'x' || serial_input == 'X' || btn == BUTTON2_PUSHED) {
+		result = editor_delete();
+		print_edit_result(result);
+	}
+	else if (serial_input == '\r' || serial_input == '\n' || btn == BUTTON3_PUSHED) {
+		uint8_t board_num;
 		
-		// Handle audio output change
-		if (handle_audio_input(serial_input)) {
-			set_game_mute_flag(get_mute_tone());
+		result = editor_save(save_slot, &board_num);
+		print_edit_result(result);
+		if (result == EDIT_OK) {
+			play_sound(button_sound);
+			next_game_board = board_num;
+			return STATE_SETUP;
 		}
+		replace_slot_flag = (result == EDIT_SLOTS_FULL);
+	}
+	else if (serial_input == 'c' || serial_input == 'C') {
+		// Leave without saving, the board is reloaded as it was.
+		play_sound(button_sound);
+		next_game_board = get_game_board_number();
+		return STATE_SETUP;
+	}
+	else {
+		acted = 0;
+	}
+	
+	// Handle joystick movement
+	joystick_adc();
+	if (handle_joystick_move(&current_player_dx, &current_player_dy)) {
+		editor_move_cursor(current_player_dx, current_player_dy);
+		acted = 1;
+	}
+	
+	// Keep the cursor shown while it is being used, else flash it
+	if (acted) {
+		last_flash_time = current_time;
+	}
+	else if (current_time >= last_flash_time + 250) {
+		editor_flash_cursor();
+		last_flash_time = current_time;
+	}
+	
+	// Handle audio output change
+	if (handle_audio_input(serial_input)) {
+		set_game_mute_flag(get_mute_tone());
 	}
 	
-	stop_animations();
+	return STATE_EDITOR;
 }
 
-// Waits for the user to press any button or s in the terminal.
-uint8_t handle_restart_wait(char serial_input) {
-	int8_t btn = button_pushed();
-	
+// Returns 0 once the user presses any button or s in the terminal, else 1.
+uint8_t handle_restart_wait(char serial_input, int8_t btn) {
 	// If the serial input is 's' or any button is pushed exit the loop
 	if (serial_input == 's' || serial_input == 'S' || btn != NO_BUTTON_PUSHED) {
 		play_sound(button_sound);
 		return 0;
 	}
-		
+	
 	return 1;
 }
 
@@ -362,7 +582,7 @@ uint8_t handle_serial_input(char serial_input, uint8_t player_num) {
 
 uint8_t handle_joysick_input(int8_t *dx, int8_t *dy, uint8_t player_num) {
 	joystick_adc();
-
+	
 	if (handle_joystick_move(dx, dy)) {
 		if (move_player(*dx, *dy, player_num, 1)) {
 			return 1;
@@ -410,6 +630,47 @@ uint8_t handle_difficulty_input(char serial_input) {
 	return difficulty_return;
 }
 
+// Return 1 if a generated game board is selected, else 0. 'g' picks a random
+// seed, 'n' lets a seed be typed in (finished with enter).
+uint8_t handle_generated_board_input(char serial_input) {
+	if (seed_entry_flag) {
+		if (serial_input >= '0' && serial_input <= '9') {
+			uint32_t seed = entered_seed * 10UL + (serial_input - '0');
+			
+			entered_seed = (seed > UINT16_MAX) ? UINT16_MAX : seed;
+			move_terminal_cursor(10,12);
+			clear_to_end_of_line();
+			printf_P(PSTR("Level Seed: %u"), entered_seed);
+		}
+		else if (serial_input == '\r' || serial_input == '\n') {
+			seed_entry_flag = 0;
+			init_game_board(set_generated_board(entered_seed, GENERATED_SNAKES, GENERATED_LADDERS));
+			print_level(GAMEBOARD_GENERATED);
+			return 1;
+		}
+		return 0;
+	}
+	
+	if (serial_input == 'g' || serial_input == 'G') {
+		uint32_t current_time = get_current_time();
+		
+		play_sound(button_sound);
+		init_game_board(set_generated_board(current_time ^ (current_time >> 16), GENERATED_SNAKES, GENERATED_LADDERS));
+		print_level(GAMEBOARD_GENERATED);
+		return 1;
+	}
+	
+	if (serial_input == 'n' || serial_input == 'N') {
+		seed_entry_flag = 1;
+		entered_seed = 0;
+		move_terminal_cursor(10,12);
+		clear_to_end_of_line();
+		printf_P(PSTR("Level Seed: "));
+	}
+	
+	return 0;
+}
+
 // Return 1 if game board is changed, else 0.
 uint8_t handle_board_change_input(char serial_input) {
 	uint8_t game_board_num;
@@ -417,8 +678,7 @@ uint8_t handle_board_change_input(char serial_input) {
 	if (serial_input == 'b' || serial_input == 'B') {
 		game_board_num = handle_game_board_num_change();
 		
-		move_terminal_cursor(10,12);
-		printf("Level: %d", game_board_num);
+		print_level(game_board_num);
 		
 		init_game_board(game_board_num);
 		
@@ -428,14 +688,10 @@ uint8_t handle_board_change_input(char serial_input) {
 	return 0;
 }
 
-// Return 1 if multiplayer/singleplayer is changed, else 0.
+// Return 1 if the number of players is changed, else 0.
 uint8_t handle_multi_player_input(char serial_input) {
-	if (serial_input == '1') {
-		set_single_player(1);
-		return 1;
-	}
-	else if (serial_input == '2') {
-		set_single_player(0);
+	if (serial_input >= '1' && serial_input < '1' + MAX_PLAYERS) {
+		set_num_players(serial_input - '0');
 		return 1;
 	}
 	
@@ -456,6 +712,32 @@ uint8_t handle_pause_input(char serial_input, uint8_t btn) {
 	return (serial_input == 'p' || serial_input == 'P' || btn == BUTTON3_PUSHED);
 }
 
+// Return 1 if a saved game was restored, else 0.
+uint8_t handle_snapshot_input(char serial_input) {
+	if (serial_input == 'k' || serial_input == 'K') {
+		save_snapshot();
+		play_sound(button_sound);
+	}
+	else if (serial_input == 'l' || serial_input == 'L') {
+		if (load_snapshot()) {
+			play_sound(button_sound);
+			return 1;
+		}
+	}
+	
+	return 0;
+}
+
+// Return 1 if a move was undone, else 0.
+uint8_t handle_undo_input(char serial_input) {
+	if ((serial_input == 'u' || serial_input == 'U') && undo_move()) {
+		play_sound(button_sound);
+		return 1;
+	}
+	
+	return 0;
+}
+
 // Print terminal UI for new game screen
 void print_new_game(void) {
 	clear_terminal();
@@ -470,13 +752,19 @@ void print_new_game(void) {
 	printf_P(PSTR("Press (b) To Select Level"));
 	
 	move_terminal_cursor(10,17);
-	printf_P(PSTR("Press (1)/(2) To Select Multi-Player Game"));
+	printf_P(PSTR("Press (1)-(4) To Select Number Of Players"));
 	
 	move_terminal_cursor(10,18);
 	printf_P(PSTR("Press (s)/(Any Button) To Start Selected Level"));
 	
 	move_terminal_cursor(10,19);
 	printf_P(PSTR("Press (q) To Mute Sound"));
+	
+	move_terminal_cursor(10,20);
+	printf_P(PSTR("Press (g) For A Random Level Or (n) To Enter A Level Seed"));
+	
+	move_terminal_cursor(10,21);
+	printf_P(PSTR("Press (c) To Edit The Selected Level"));
 }
 
 // Print terminal UI for current game mode
@@ -487,7 +775,7 @@ void print_multi_player(void) {
 		printf_P(PSTR("Mode : Single-Player"));
 	}
 	else {
-		printf_P(PSTR("Mode : Multi-Player"));
+		printf_P(PSTR("Mode : %d-Player"), get_num_players());
 	}
 
 }
@@ -495,7 +783,7 @@ void print_multi_player(void) {
 // Print terminal UI for start game screen
 void print_start_game(void) {
 	clear_terminal();
-		
+	
 	move_terminal_cursor(0, 0);
 	printf_P(PSTR("Time Remaining: "));
 	
@@ -504,10 +792,10 @@ void print_start_game(void) {
 	
 	move_terminal_cursor(10,12);
 	printf_P(PSTR("Dice: Stopped"));
-		
+	
 	
 	move_terminal_cursor(10,13);
-	printf("Dice Number: %d", 0);
+	printf_P(PSTR("Dice Number: %d"), 0);
 	
 	move_terminal_cursor(10,15);
 	printf_P(PSTR("Press (e)/(m)/(h) To Select Difficulty"));
@@ -518,9 +806,79 @@ void print_start_game(void) {
 	move_terminal_cursor(10,17);
 	printf_P(PSTR("Press (q) To Mute Sound"));
 	
+	move_terminal_cursor(10,18);
+	printf_P(PSTR("Press (k)/(l) To Save/Load Game"));
+	
+	move_terminal_cursor(10,19);
+	printf_P(PSTR("Press (u) To Undo Move"));
+	
 	print_difficulty();
 }
 
+// Print terminal UI for the board editor
+void print_editor(void) {
+	clear_terminal();
+	
+	move_terminal_cursor(10,10);
+	printf_P(PSTR("LEVEL EDITOR"));
+	
+	move_terminal_cursor(10,14);
+	printf_P(PSTR("Press (w)/(a)/(s)/(d)/(Joystick) To Move The Cursor"));
+	
+	move_terminal_cursor(10,15);
+	printf_P(PSTR("Press (n)/(B0) At The Start Then End Of A Snake"));
+	
+	move_terminal_cursor(10,16);
+	printf_P(PSTR("Press (l)/(B1) At The Start Then End Of A Ladder"));
+	
+	move_terminal_cursor(10,17);
+	printf_P(PSTR("Press (x)/(B2) To Delete A Snake Or Ladder"));
+	
+	move_terminal_cursor(10,18);
+	printf_P(PSTR("Press (Enter)/(B3) To Save Or (c) To Leave Without Saving"));
+	
+	move_terminal_cursor(10,19);
+	printf_P(PSTR("Press (q) To Mute Sound"));
+}
+
+// Print terminal UI for the result of an editor action
+void print_edit_result(uint8_t result) {
+	move_terminal_cursor(10,12);
+	clear_to_end_of_line();
+	
+	switch (result) {
+		case EDIT_OK:
+			break;
+		case EDIT_MARKED:
+			printf_P(PSTR("Move To The End And Press Again"));
+			break;
+		case EDIT_TAKEN:
+			printf_P(PSTR("Square Already Used"));
+			break;
+		case EDIT_WRONG_WAY:
+			printf_P(PSTR("Snakes Must Go Down And Ladders Up"));
+			break;
+		case EDIT_TOO_LONG:
+			printf_P(PSTR("Too Long, Not Enough Squares Left"));
+			break;
+		case EDIT_FULL:
+			printf_P(PSTR("At Most %d Snakes And Ladders"), MAX_LEVEL_LINKS);
+			break;
+		case EDIT_NOTHING:
+			printf_P(PSTR("Nothing To Delete"));
+			break;
+		case EDIT_UNREACHABLE:
+			printf_P(PSTR("The Finish Cannot Be Reached"));
+			break;
+		case EDIT_SLOTS_FULL:
+			printf_P(PSTR("Slots Full, Press (1)-(%d) To Replace One"), UPLOAD_SLOTS);
+			break;
+		default:
+			printf_P(PSTR("Upload In Progress, Not Saved"));
+			break;
+	};
+}
+
 // Print terminal UI for game over
 void print_game_over(void) {
 	clear_terminal();
@@ -532,10 +890,19 @@ void print_game_over(void) {
 	
 	switch (get_game_winner()) {
 		case PLAYER_1:
-			printf("Player 1 Wins!");
+			printf_P(PSTR("Player 1 Wins!"));
 			break;
 		case PLAYER_2:
-			printf("Player 2 Wins!");
+			printf_P(PSTR("Player 2 Wins!"));
+			break;
+		case PLAYER_3:
+			printf_P(PSTR("Player 3 Wins!"));
+			break;
+		case PLAYER_4:
+			printf_P(PSTR("Player 4 Wins!"));
+			break;
+		default:
+			printf_P(PSTR("Out Of Time!"));
 			break;
 	};
 	
@@ -547,6 +914,22 @@ void print_game_over(void) {
 }
 
 
+// Print terminal UI for the selected level
+void print_level(uint8_t game_board_num) {
+	move_terminal_cursor(10,12);
+	clear_to_end_of_line();
+	
+	if (game_board_num == GAMEBOARD_GENERATED) {
+		printf_P(PSTR("Level: Generated (Seed: %u)"), get_generated_seed());
+	}
+	else if (game_board_num > get_num_levels()) {
+		printf_P(PSTR("Level: Uploaded %d/%d"), game_board_num - get_num_levels(), UPLOAD_SLOTS);
+	}
+	else {
+		printf_P(PSTR("Level: %d/%d (Best: %d Rolls)"), game_board_num, get_num_levels(), get_level_min_rolls(game_board_num));
+	}
+}
+
 // Print terminal UI for current game difficulty
 void print_difficulty(void) {
 	uint8_t difficulty_num = get_game_difficulty();
@@ -556,15 +939,15 @@ void print_difficulty(void) {
 	
 	switch (difficulty_num) {
 		case EASY:
-			printf("Difficulty: Easy");
+			printf_P(PSTR("Difficulty: Easy"));
 			move_terminal_cursor(17,0);
 			clear_to_end_of_line();
 			break;
 		case MEDIUM:
-			printf("Difficulty: Medium");
+			printf_P(PSTR("Difficulty: Medium"));
 			break;
 		case HARD:
-			printf("Difficulty: Hard");
+			printf_P(PSTR("Difficulty: Hard"));
 			break;
 	}
 }
@@ -579,11 +962,11 @@ void print_difficulty_time(uint16_t player_time) {
 	
 	// Print game time
 	if (time_remaining > 1000)	{
-		printf("%d", time_remaining / 100);
+		printf_P(PSTR("%d"), time_remaining / 100);
 	}
 	else if (time_remaining >= 0 && time_remaining <= 1000)	{
 		// Print game time in ms if game time is less than 10 seconds
-		printf("%d:%d", time_remaining / 100, time_remaining % 100);
+		printf_P(PSTR("%d:%d"), time_remaining / 100, time_remaining % 100);
 	}
 }
 
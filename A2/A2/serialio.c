@@ -25,6 +25,7 @@
 #include <stdint.h>
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include "levelupload.h"
 
 /* System clock rate in Hz. (L at the end indicates this is a long constant) */
 #define SYSCLK 8000000L
@@ -40,8 +41,14 @@
  * to the beginning (assuming those bytes have been output).
  * NOTE - OUTPUT_BUFFER_SIZE can not be larger than 255 without changing
  * the type of the variables below (currently defined as 8 bit unsigned ints).
+ * Tall boards leave less RAM free, so less is buffered for them (output then
+ * waits for room in the buffer sooner).
  */
+#if HEIGHT > 16
+#define OUTPUT_BUFFER_SIZE 128
+#else
 #define OUTPUT_BUFFER_SIZE 255
+#endif
 volatile char out_buffer[OUTPUT_BUFFER_SIZE];
 volatile uint8_t out_insert_pos;
 volatile uint8_t bytes_in_out_buffer;
@@ -273,6 +280,13 @@ ISR(USART0_RX_vect)
 	/* Read the character - we ignore the possibility of overrun. */
 	char c;
 	c = UDR0;
+	
+	/* Bytes of a level upload frame are handled by the upload module
+	 * and never reach the input buffer.
+	 */
+	if(upload_receive_byte(c)) {
+		return;
+	}
 		
 	if(do_echo && bytes_in_out_buffer < OUTPUT_BUFFER_SIZE) {
 		/* If echoing is enabled and there is output buffer
@@ -6,11 +6,12 @@
  */ 
 
 #include <avr/io.h>
+#include <avr/pgmspace.h>
 #include <stdint.h>
 #include "seven_seg.h"
 #include "timer0.h"
 
-const uint8_t seven_seg[17] = {63,6,91,79,102,109,125,7,127,111,119,124,57,94,121,113,0};
+const uint8_t seven_seg[17] PROGMEM = {63,6,91,79,102,109,125,7,127,111,119,124,57,94,121,113,0};
 
 uint8_t seven_seg_cc;
 uint8_t seven_seg_left;
@@ -39,12 +40,12 @@ void sevenseg_display(void) {
 		if (seven_seg_cc) {
 			// Write to GPIO registers to display left digit
 			PORTD |= (1 << PORTD2);
-			PORTC = seven_seg[seven_seg_left];
+			PORTC = pgm_read_byte(&seven_seg[seven_seg_left]);
 		}
 		else {
 			// Write to GPIO registers to display right digit
 			PORTD &= ~(1 << PORTD2);
-			PORTC = seven_seg[seven_seg_right];
+			PORTC = pgm_read_byte(&seven_seg[seven_seg_right]);
 		}
 		
 		// Toggle seven segment display
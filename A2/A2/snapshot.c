@@ -0,0 +1,76 @@
+/*
+ * snapshot.c
+ *
+ * Created: 17/10/2026 10:12:40 AM
+ *  Author: LiamM
+ */ 
+
+#include <stdint.h>
+#include <avr/eeprom.h>
+#include "snapshot.h"
+#include "game.h"
+#include "dice.h"
+#include "buzzer.h"
+#include "prand_number_gen.h"
+
+// Snapshot saved by save_snapshot(). Unprogrammed EEPROM reads as 0xFF, which
+// is never a valid version.
+static uint8_t EEMEM eeprom_snapshot[SNAPSHOT_MAX_SIZE];
+
+// Write a snapshot of the current game into buffer.
+uint8_t pack_snapshot(uint8_t* buffer) {
+	uint8_t length = 2;
+	
+	length += pack_game_state(buffer + length);
+	buffer[length++] = get_dice_state();
+	buffer[length++] = p_rand_state();
+	buffer[length++] = get_game_mute_flag() | (get_mute_tone() << 1);
+	
+	buffer[0] = SNAPSHOT_VERSION;
+	buffer[1] = length - 2;
+	
+	return length;
+}
+
+// Restore the game from a snapshot. Returns 1 on success, 0 otherwise.
+uint8_t unpack_snapshot(const uint8_t* buffer, uint8_t length) {
+	if (length < 2 || buffer[0] != SNAPSHOT_VERSION) return 0;
+	
+	uint8_t payload_length = buffer[1];
+	
+	if (payload_length < 3 || payload_length > length - 2 || payload_length > SNAPSHOT_MAX_SIZE - 2) {
+		return 0;
+	}
+	
+	// The game state checks itself before changing anything. The three bytes
+	// after it must also be present.
+	uint8_t game_length = unpack_game_state(buffer + 2, payload_length - 3);
+	if (game_length == 0) return 0;
+	
+	const uint8_t* tail = buffer + 2 + game_length;
+	
+	set_dice_state(tail[0]);
+	p_rand_seed(tail[1]);
+	set_game_mute_flag(tail[2] & 0x01);
+	set_mute_tone((tail[2] >> 1) & 0x01);
+	
+	return 1;
+}
+
+// Save a snapshot of the current game to EEPROM.
+void save_snapshot(void) {
+	uint8_t buffer[SNAPSHOT_MAX_SIZE];
+	uint8_t length = pack_snapshot(buffer);
+	
+	// eeprom_update_block only writes bytes that changed.
+	eeprom_update_block(buffer, eeprom_snapshot, length);
+}
+
+// Restore the game saved in EEPROM. Returns 1 on success, 0 otherwise.
+uint8_t load_snapshot(void) {
+	uint8_t buffer[SNAPSHOT_MAX_SIZE];
+	
+	eeprom_read_block(buffer, eeprom_snapshot, SNAPSHOT_MAX_SIZE);
+	
+	return unpack_snapshot(buffer, SNAPSHOT_MAX_SIZE);
+}
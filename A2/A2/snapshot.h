@@ -0,0 +1,43 @@
+/*
+ * snapshot.h
+ *
+ * Created: 17/10/2026 10:12:40 AM
+ *  Author: LiamM
+ *
+ * Compact snapshots of everything needed to resume a game exactly: the game
+ * state from game.c, the dice, the random number generator and the audio
+ * settings. A snapshot is at most SNAPSHOT_MAX_SIZE bytes laid out as
+ *   0: SNAPSHOT_VERSION
+ *   1: number of bytes that follow
+ *   game state (see pack_game_state() in game.c)
+ *   dice state, random number generator state,
+ *   audio flags (bit 0 game mute, bit 1 tone mute)
+ */ 
+
+
+#ifndef SNAPSHOT_H_
+#define SNAPSHOT_H_
+
+#include <stdint.h>
+#include "game.h"
+
+// Increment whenever the layout of any part of the snapshot changes.
+#define SNAPSHOT_VERSION 3
+
+#define SNAPSHOT_MAX_SIZE (2 + GAME_STATE_MAX_SIZE + 3)
+
+// Write a snapshot of the current game into buffer (at least
+// SNAPSHOT_MAX_SIZE bytes). Returns the number of bytes written.
+uint8_t pack_snapshot(uint8_t* buffer);
+
+// Restore the game from a snapshot. Returns 1 on success, or 0 if the
+// snapshot is invalid or from another version (the game is left unchanged).
+uint8_t unpack_snapshot(const uint8_t* buffer, uint8_t length);
+
+// Save a snapshot of the current game to EEPROM.
+void save_snapshot(void);
+
+// Restore the game saved in EEPROM. Returns 1 on success, 0 otherwise.
+uint8_t load_snapshot(void);
+
+#endif /* SNAPSHOT_H_ */
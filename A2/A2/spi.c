@@ -6,7 +6,60 @@
 
 #include "spi.h"
 #include <avr/io.h>
+#include <avr/interrupt.h>
 
+// Bytes waiting to be sent by the transmit interrupt. The main loop is the
+// only producer (moves spi_queue_tail) and the interrupt the only consumer
+// (moves spi_queue_head), so neither needs to disable interrupts. The indices
+// run freely and are masked on access.
+static uint8_t spi_queue[SPI_QUEUE_SIZE];
+static volatile uint8_t spi_queue_head;
+static volatile uint8_t spi_queue_tail;
+// Set from the first byte being written to the data register until the
+// queue runs dry
+static volatile uint8_t spi_sending;
+static uint8_t spi_high_water;
+
+#ifdef LEDMATRIX_USART1
+// USART1 in master SPI mode. The data register is double buffered, so the
+// data register empty interrupt hands over each byte while the one before is
+// still being shifted out and the bytes go back to back.
+#define SPI_DATA			UDR1
+#define SPI_READY()			(UCSR1A & (1 << UDRE1))
+#define SPI_INTERRUPT_ON()	(UCSR1B |= (1 << UDRIE1))
+#define SPI_INTERRUPT_OFF()	(UCSR1B &= ~(1 << UDRIE1))
+#define SPI_VECTOR			USART1_UDRE_vect
+#else
+// SPI0, interrupting when each byte has been sent.
+#define SPI_DATA			SPDR0
+#define SPI_READY()			(SPSR0 & (1 << SPIF0))
+#define SPI_INTERRUPT_ON()	(SPCR0 |= (1 << SPIE0))
+#define SPI_INTERRUPT_OFF()	(SPCR0 &= ~(1 << SPIE0))
+#define SPI_VECTOR			SPI_STC_vect
+#endif
+
+#ifdef LEDMATRIX_USART1
+void spi_setup_master(uint8_t clockdivider) {
+	// Set up USART1 as an SPI master (MSPIM), in SPI mode 0 with the most
+	// significant bit first as SPI0 would be. TXD1 (pin 3 of port D) takes
+	// the place of MOSI and XCK1 (pin 4 of port D) of SCK. Nothing is
+	// received from the LED matrix so the receiver is left off.
+	// The baud rate register must be zero while the USART is set up.
+	UBRR1 = 0;
+	
+	// XCK1 being an output makes the USART the master
+	DDRD |= (1 << DDD4);
+	UCSR1C = (1 << UMSEL11) | (1 << UMSEL10);
+	UCSR1B = (1 << TXEN1);
+	
+	// The SPI clock is the CPU clock divided by 2 * (UBRR1 + 1)
+	UBRR1 = clockdivider / 2 - 1;
+	
+	// The slave select (SS) line stays on pin 4 of port B, taken low
+	DDRB |= (1 << DDB4);
+	PORTB &= ~(1 << PORTB4);
+}
+#else
 void spi_setup_master(uint8_t clockdivider) {
 	// Set up SPI communication as a master
 	// Make the SS, MOSI and SCK pins outputs. These are pins
@@ -52,8 +105,90 @@ void spi_setup_master(uint8_t clockdivider) {
 	// Take SS (slave select) line low
 	PORTB &= ~(1 << PORTB4);
 }
+#endif
+
+// Called when a byte has been sent: start on the next byte, or stop the
+// interrupt when the queue is empty.
+static void spi_send_next(void) {
+	uint8_t head = spi_queue_head;
+	
+	if (head == spi_queue_tail) {
+		SPI_INTERRUPT_OFF();
+		spi_sending = 0;
+		return;
+	}
+	SPI_DATA = spi_queue[head & (SPI_QUEUE_SIZE - 1)];
+	spi_queue_head = head + 1;
+}
+
+ISR(SPI_VECTOR) {
+	spi_send_next();
+}
+
+// Wait for the transmission to move on. With interrupts disabled (e.g. in an
+// ATOMIC_BLOCK) the interrupt cannot run, so the transfer is polled instead.
+static void spi_wait(void) {
+	if (!(SREG & (1 << SREG_I)) && spi_sending && SPI_READY()) {
+		spi_send_next();
+	}
+}
 
+uint8_t spi_queue_free(void) {
+	return SPI_QUEUE_SIZE - (uint8_t) (spi_queue_tail - spi_queue_head);
+}
+
+void spi_queue_byte(uint8_t byte) {
+	while (spi_queue_free() == 0) {
+		spi_wait();
+	}
+	
+	uint8_t tail = spi_queue_tail;
+	
+	spi_queue[tail & (SPI_QUEUE_SIZE - 1)] = byte;
+	// The byte must be stored before the interrupt can see it.
+	__asm__ __volatile__ ("" ::: "memory");
+	spi_queue_tail = tail + 1;
+	
+	uint8_t queued = (uint8_t) (spi_queue_tail - spi_queue_head);
+	if (queued > spi_high_water) spi_high_water = queued;
+	
+	// Start sending if the interrupt has stopped. It only stops once the queue
+	// is empty, so it cannot be running now.
+	if (!spi_sending) {
+		spi_sending = 1;
+		spi_send_next();
+		SPI_INTERRUPT_ON();
+	}
+}
+
+void spi_flush(void) {
+	while (spi_sending) {
+		spi_wait();
+	}
+}
+
+uint8_t spi_get_high_water(void) {
+	return spi_high_water;
+}
+
+#ifdef LEDMATRIX_USART1
 uint8_t spi_send_byte(uint8_t byte) {
+	// Let the queue finish first so the transfers do not collide.
+	spi_flush();
+	
+	// The receiver is off, so the byte is only sent. It follows any byte
+	// still being shifted out.
+	while ((UCSR1A & (1 << UDRE1)) == 0) {
+		; // wait
+	}
+	UDR1 = byte;
+	return 0;
+}
+#else
+uint8_t spi_send_byte(uint8_t byte) {
+	// Let the queue finish first so the transfers do not collide.
+	spi_flush();
+	
 	// Write out the byte to the SPDR0 register. This will initiate
 	// the transfer. We then wait until the most significant byte of
 	// SPSR0 (SPIF0 bit) is set - this indicates that the transfer is
@@ -65,4 +200,5 @@ uint8_t spi_send_byte(uint8_t byte) {
 		; // wait
 	}
 	return SPDR0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
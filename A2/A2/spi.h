@@ -10,13 +10,41 @@
 
 #include <stdint.h>
 
+// The LED matrix is driven from SPI0 unless built with -DLEDMATRIX_USART1,
+// which drives it from USART1 in master SPI mode instead, leaving SPI0 free.
+// USART1 sends queued bytes back to back, where SPI0 leaves a gap after each
+// byte for the interrupt. The matrix's MOSI and SCK are then wired to TXD1
+// (PD3) and XCK1 (PD4), which are the dice LED and buzzer pins on this board:
+// the buzzer is taken off PD4 (see buzzer.c) and the dice LED is not shown.
+
 // Set up SPI communication as a master.
 // clockdivider should be one of 2,4,8,16,32,64,128
 void spi_setup_master(uint8_t clockdivider);
 
 // Send and receive an SPI byte. This function will take at least 8 
-// cyles of the divided clock (i.e. will busy wait).
+// cyles of the divided clock (i.e. will busy wait). Anything queued is sent
+// first. With USART1 the byte is only sent, and 0 returned.
 uint8_t spi_send_byte(uint8_t byte);
 
+// Size of the transmit queue. Must be a power of two, at most 128.
+#define SPI_QUEUE_SIZE	128
+
+// Queue a byte to be sent by the SPI transfer complete interrupt, so sending
+// costs the caller little more than storing the byte. Only the main loop may
+// queue bytes. Blocks only if the queue is full, which spi_queue_free() can be
+// used to avoid.
+void spi_queue_byte(uint8_t byte);
+
+// Return the number of bytes that can be queued without waiting.
+uint8_t spi_queue_free(void);
+
+// Wait until every queued byte has been sent (with USART1, until the last
+// one is being shifted out).
+void spi_flush(void);
+
+// Return the most bytes that have been waiting in the queue at once, to
+// check the queue size against what is drawn.
+uint8_t spi_get_high_water(void);
+
 
 #endif /* SPI_H_ */
\ No newline at end of file
@@ -0,0 +1,751 @@
+/*
+ * levelc.c
+ *
+ * Created: 17/10/2026 9:05:12 PM
+ *  Author: LiamM
+ *
+ * Host level compiler. Reads ASCII level files, checks them and writes the
+ * packed level pack (see gameboard.h) as a C header for gameboard.c, so the
+ * device never has to validate or preprocess a board.
+ *
+ * Build and run on the host from the project directory:
+ *   gcc -O2 -o tools/levelc tools/levelc.c -lm
+ *   tools/levelc -o level_pack.h levels/level*.txt
+ * For taller boards (see BOARD_HEIGHT in game.h) build levelc with the same
+ * height, e.g. gcc -O2 -DBOARD_HEIGHT=64 ..., and give it level files of that
+ * many rows, e.g. tools/levelc -o level_pack.h levels/tall/level*.txt
+ * The project's pre-build step runs tools\levelc.exe when it has been built.
+ * With -b, levelc instead writes a single level as raw packed bytes, ready to
+ * be uploaded over serial into an EEPROM slot (see levelupload.h):
+ *   tools/levelc -b level.bin levels/level05.txt
+ * With -a, levelc writes nothing but rates each level by solving the Markov
+ * chain of a player's position exactly: the expected number of rolls to
+ * finish and its standard deviation, one line per level. -v adds a map of how
+ * often each square is landed on in an average game. Any number of levels
+ * may be given, so candidate layouts can be scored in bulk:
+ *   tools/levelc -a [-v] levels/level*.txt
+ *
+ * A level file holds HEIGHT rows of WIDTH cells, top row (the finish row)
+ * first. Cells are two characters separated by spaces:
+ *   ..  empty               @@  start point       ##  finish line
+ *   Sn  snake start n       sn  snake end n       ss  snake body
+ *   Ln  ladder start n      ln  ladder end n      ll  ladder body
+ *   xx  snake and ladder body crossing
+ * where n is a hex digit from 1 to F pairing each start with its end. Blank
+ * lines and lines starting with ';' are ignored.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "../game.h"
+#include "../gameboard.h"
+
+#define MAX_LEVELS		255
+#define MAX_LINE		256
+#define NUM_DICE_SIDES	6
+
+// Links of one kind are indexed by identifier, [0] for snakes, [1] for ladders
+#define KIND_SNAKE	0
+#define KIND_LADDER	1
+
+typedef struct {
+	packed_square start;
+	packed_square end;
+	uint8_t num_starts;
+	uint8_t num_ends;
+} link_pair;
+
+typedef struct {
+	uint8_t kind;
+	uint8_t id;
+	packed_square start;
+	packed_square end;
+	packed_square destination;
+	uint8_t body_length;
+	packed_square body[MAX_LEVEL_BODY];
+} compiled_link;
+
+typedef struct {
+	const char* file_name;
+	uint8_t object[WIDTH][HEIGHT];
+	uint8_t num_links;
+	compiled_link links[MAX_LEVEL_LINKS];
+	uint8_t min_rolls;
+} compiled_level;
+
+static compiled_level levels[MAX_LEVELS];
+
+// Report an error in a level file and stop.
+static void level_error(const char* file_name, const char* message, int x, int y) {
+	if (x >= 0) {
+		fprintf(stderr, "%s: (%d,%d): %s\n", file_name, x, y, message);
+	}
+	else {
+		fprintf(stderr, "%s: %s\n", file_name, message);
+	}
+	exit(1);
+}
+
+// Return the hex value of an identifier character, or 0 if it is not 1-F.
+static uint8_t parse_identifier(char c) {
+	if (c >= '1' && c <= '9') return c - '0';
+	if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+	if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+	return 0;
+}
+
+// Convert a two character cell to a game object, returns 0xFF if invalid.
+static uint8_t parse_cell(const char* cell) {
+	if (strcmp(cell, "..") == 0) return EMPTY_SQUARE;
+	if (strcmp(cell, "@@") == 0) return START_POINT;
+	if (strcmp(cell, "##") == 0) return FINISH_LINE;
+	if (strcmp(cell, "ss") == 0) return SNAKE_MIDDLE;
+	if (strcmp(cell, "ll") == 0) return LADDER_MIDDLE;
+	if (strcmp(cell, "xx") == 0) return SNAKE_LADDER_MIDDLE;
+
+	if (strlen(cell) != 2) return 0xFF;
+
+	uint8_t id = parse_identifier(cell[1]);
+	if (id == 0) return 0xFF;
+
+	switch (cell[0]) {
+		case 'S':
+			return SNAKE_START | id;
+		case 's':
+			return SNAKE_END | id;
+		case 'L':
+			return LADDER_START | id;
+		case 'l':
+			return LADDER_END | id;
+		default:
+			return 0xFF;
+	}
+}
+
+// Read the grid of a level file into level->object.
+static void read_level(const char* file_name, compiled_level* level) {
+	char line[MAX_LINE];
+	int row = 0;
+	FILE* file = fopen(file_name, "r");
+
+	if (!file) level_error(file_name, "cannot open file", -1, -1);
+	level->file_name = file_name;
+
+	while (fgets(line, sizeof(line), file)) {
+		char* cell = strtok(line, " \t\r\n");
+		int x = 0;
+
+		if (!cell || cell[0] == ';') continue;
+		if (row >= HEIGHT) level_error(file_name, "too many rows", -1, -1);
+
+		int y = HEIGHT - 1 - row;
+		for (; cell; cell = strtok(NULL, " \t\r\n"), x++) {
+			if (x >= WIDTH) level_error(file_name, "too many cells in row", x, y);
+
+			uint8_t object = parse_cell(cell);
+			if (object == 0xFF) level_error(file_name, "unknown cell", x, y);
+			level->object[x][y] = object;
+		}
+		if (x < WIDTH) level_error(file_name, "too few cells in row", x, y);
+		row++;
+	}
+	fclose(file);
+
+	if (row < HEIGHT) level_error(file_name, "too few rows", -1, -1);
+}
+
+// Return the number of king moves between two packed squares.
+static int square_distance(packed_square a, packed_square b) {
+	int dx = abs(UNPACK_SQUARE_X(a) - UNPACK_SQUARE_X(b));
+	int dy = abs(UNPACK_SQUARE_Y(a) - UNPACK_SQUARE_Y(b));
+
+	return (dx > dy) ? dx : dy;
+}
+
+// Follow the body of a link from its start to its end. Each step takes the
+// unvisited neighbouring body square (of middle_type or a crossing) closest
+// to the end. Returns 0 if the body does not reach the end.
+static int trace_body(compiled_level* level, compiled_link* link, uint8_t middle_type) {
+	packed_square square = link->start;
+
+	link->body_length = 0;
+
+	while (square_distance(square, link->end) > 1) {
+		int best_square = -1;
+		int best_distance = 0xFF;
+
+		if (link->body_length >= MAX_LEVEL_BODY) return 0;
+
+		for (int dx = -1; dx <= 1; dx++) {
+			for (int dy = -1; dy <= 1; dy++) {
+				int x = UNPACK_SQUARE_X(square) + dx;
+				int y = UNPACK_SQUARE_Y(square) + dy;
+
+				if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT) continue;
+
+				uint8_t object_type = level->object[x][y] & 0xF0;
+				packed_square next = PACK_SQUARE(x, y);
+
+				if (object_type != middle_type && object_type != SNAKE_LADDER_MIDDLE) continue;
+
+				int visited = 0;
+				for (int i = 0; i < link->body_length; i++) {
+					if (link->body[i] == next) visited = 1;
+				}
+
+				if (!visited && square_distance(next, link->end) < best_distance) {
+					best_distance = square_distance(next, link->end);
+					best_square = next;
+				}
+			}
+		}
+
+		if (best_square < 0) return 0;
+
+		link->body[link->body_length++] = best_square;
+		square = best_square;
+	}
+	return 1;
+}
+
+// Return the link starting on a square, or NULL if there is none.
+static compiled_link* link_starting_at(compiled_level* level, packed_square square) {
+	for (int i = 0; i < level->num_links; i++) {
+		if (level->links[i].start == square) return &level->links[i];
+	}
+	return NULL;
+}
+
+// Path index of a packed square
+static int path_index(packed_square square) {
+	return SQUARE_INDEX(UNPACK_SQUARE_X(square), UNPACK_SQUARE_Y(square));
+}
+
+// Where landing on each square leads, by path index, on the level last given
+// to build_jump_table(): the destination of a snake or ladder starting there,
+// else the square itself. Moves are made with roll_destination() (see game.h)
+// and level_jump(), so levelc follows the same rule as the game.
+static square_index jump_table[BOARD_SQUARES];
+
+static void build_jump_table(const compiled_level* level) {
+	for (int i = 0; i < BOARD_SQUARES; i++) {
+		jump_table[i] = i;
+	}
+	for (int i = 0; i < level->num_links; i++) {
+		jump_table[path_index(level->links[i].start)] = path_index(level->links[i].destination);
+	}
+}
+
+static square_index level_jump(square_index square) {
+	return jump_table[square];
+}
+
+// Check a level and work out its links, body paths, destinations and the
+// fewest dice rolls needed to finish.
+static void compile_level(compiled_level* level) {
+	const char* name = level->file_name;
+	link_pair pairs[2][16];
+	uint8_t body_uses[2][WIDTH][HEIGHT];
+	int num_start = 0;
+	int num_finish = 0;
+
+	memset(pairs, 0, sizeof(pairs));
+	memset(body_uses, 0, sizeof(body_uses));
+
+	// Pair up snake and ladder starts and ends by identifier.
+	for (int x = 0; x < WIDTH; x++) {
+		for (int y = 0; y < HEIGHT; y++) {
+			uint8_t type = level->object[x][y] & 0xF0;
+			uint8_t id = level->object[x][y] & 0x0F;
+			uint8_t kind = (type == LADDER_START || type == LADDER_END) ? KIND_LADDER : KIND_SNAKE;
+
+			if (type == START_POINT) num_start++;
+			if (type == FINISH_LINE) num_finish++;
+
+			if (type == SNAKE_START || type == LADDER_START) {
+				pairs[kind][id].start = PACK_SQUARE(x, y);
+				pairs[kind][id].num_starts++;
+			}
+			else if (type == SNAKE_END || type == LADDER_END) {
+				pairs[kind][id].end = PACK_SQUARE(x, y);
+				pairs[kind][id].num_ends++;
+			}
+		}
+	}
+
+	int last = BOARD_SQUARES - 1;
+	if (num_start != 1 || (level->object[0][0] & 0xF0) != START_POINT) {
+		level_error(name, "needs a single start point (@@) in the bottom left corner", -1, -1);
+	}
+	if (num_finish != 1 || (level->object[SQUARE_INDEX_X(last)][SQUARE_INDEX_Y(last)] & 0xF0) != FINISH_LINE) {
+		level_error(name, "needs a single finish line (##) on the last square of the path", -1, -1);
+	}
+
+	level->num_links = 0;
+	for (int kind = KIND_SNAKE; kind <= KIND_LADDER; kind++) {
+		for (int id = 1; id < 16; id++) {
+			link_pair* pair = &pairs[kind][id];
+			const char* kind_name = (kind == KIND_SNAKE) ? "snake" : "ladder";
+			char message[64];
+
+			if (pair->num_starts == 0 && pair->num_ends == 0) continue;
+
+			if (pair->num_starts != 1 || pair->num_ends != 1) {
+				sprintf(message, "%s %X needs exactly one start and one end", kind_name, id);
+				level_error(name, message, -1, -1);
+			}
+			if (kind == KIND_SNAKE && path_index(pair->end) >= path_index(pair->start)) {
+				sprintf(message, "snake %X must end before its start", id);
+				level_error(name, message, UNPACK_SQUARE_X(pair->start), UNPACK_SQUARE_Y(pair->start));
+			}
+			if (kind == KIND_LADDER && path_index(pair->end) <= path_index(pair->start)) {
+				sprintf(message, "ladder %X must end after its start", id);
+				level_error(name, message, UNPACK_SQUARE_X(pair->start), UNPACK_SQUARE_Y(pair->start));
+			}
+			if (level->num_links >= MAX_LEVEL_LINKS) {
+				level_error(name, "too many snakes and ladders", -1, -1);
+			}
+
+			compiled_link* link = &level->links[level->num_links++];
+			link->kind = kind;
+			link->id = id;
+			link->start = pair->start;
+			link->end = pair->end;
+
+			if (!trace_body(level, link, (kind == KIND_SNAKE) ? SNAKE_MIDDLE : LADDER_MIDDLE)) {
+				sprintf(message, "%s %X body does not lead from its start to its end", kind_name, id);
+				level_error(name, message, UNPACK_SQUARE_X(pair->start), UNPACK_SQUARE_Y(pair->start));
+			}
+			for (int i = 0; i < link->body_length; i++) {
+				body_uses[kind][UNPACK_SQUARE_X(link->body[i])][UNPACK_SQUARE_Y(link->body[i])]++;
+			}
+		}
+	}
+
+	// Every body square must belong to exactly one snake and/or one ladder.
+	int pool_used = 0;
+	for (int i = 0; i < level->num_links; i++) {
+		pool_used += level->links[i].body_length;
+	}
+	if (pool_used > LEVEL_BODY_POOL_SIZE) {
+		level_error(name, "snake and ladder bodies are too long in total", -1, -1);
+	}
+
+	for (int x = 0; x < WIDTH; x++) {
+		for (int y = 0; y < HEIGHT; y++) {
+			uint8_t type = level->object[x][y] & 0xF0;
+			uint8_t snakes = body_uses[KIND_SNAKE][x][y];
+			uint8_t ladders = body_uses[KIND_LADDER][x][y];
+
+			if (snakes > 1 || ladders > 1) {
+				level_error(name, "body square shared by two snakes or two ladders", x, y);
+			}
+			if ((type == SNAKE_MIDDLE && snakes == 0) ||
+					(type == LADDER_MIDDLE && ladders == 0) ||
+					(type == SNAKE_LADDER_MIDDLE && (snakes == 0 || ladders == 0))) {
+				level_error(name, "body square not on the path of any snake or ladder", x, y);
+			}
+		}
+	}
+
+	// Follow chained jumps to the final destination of each link.
+	for (int i = 0; i < level->num_links; i++) {
+		packed_square square = level->links[i].end;
+		int hops = 0;
+		compiled_link* next;
+
+		while ((next = link_starting_at(level, square)) != NULL) {
+			if (++hops > MAX_LEVEL_LINKS) {
+				level_error(name, "snakes and ladders form a loop", UNPACK_SQUARE_X(square), UNPACK_SQUARE_Y(square));
+			}
+			square = next->end;
+		}
+		level->links[i].destination = square;
+	}
+
+	// Breadth first search over the path for the fewest rolls to finish.
+	uint8_t rolls[BOARD_SQUARES];
+	int queue[BOARD_SQUARES];
+	int head = 0;
+	int tail = 0;
+
+	build_jump_table(level);
+	memset(rolls, 0xFF, sizeof(rolls));
+	rolls[0] = 0;
+	queue[tail++] = 0;
+
+	while (head < tail) {
+		int index = queue[head++];
+
+		for (int dice = 1; dice <= NUM_DICE_SIDES; dice++) {
+			int target = roll_destination(index, dice, level_jump);
+
+			if (rolls[target] == 0xFF) {
+				rolls[target] = rolls[index] + 1;
+				queue[tail++] = target;
+			}
+		}
+	}
+
+	if (rolls[last] == 0xFF) {
+		level_error(name, "the finish cannot be reached from the start", -1, -1);
+	}
+	level->min_rolls = rolls[last];
+}
+
+// Markov chain analysis. After each roll a player is on one of the squares a
+// roll can finish on, every square but the starts of snakes and ladders,
+// which move the player on straight away (to the destination, as in
+// handle_player_collision()). The finish absorbs. With Q the chances of going
+// between the other squares in one roll and N = (I - Q)^-1, the expected
+// rolls to finish from each square are t = N 1, their variance is
+// 2 N t - t - t^2, and row 0 of N is the expected number of rolls made from
+// each square in a game starting on square 0.
+typedef struct {
+	double expected_rolls;
+	double deviation;
+	double landings[BOARD_SQUARES];	// Expected landings per game, by path index
+} level_stats;
+
+// I - Q over the squares reachable from the start, in path order, and then
+// its LU factors. Only columns row_first[i] to row_last[i] of row i are ever
+// used (and cleared).
+static double chain[BOARD_SQUARES][BOARD_SQUARES];
+static int row_first[BOARD_SQUARES];
+static int row_last[BOARD_SQUARES];
+
+// Factorise the n by n matrix in chain into unit lower and upper triangular
+// factors in place. I - Q is an M-matrix so no pivoting is needed, and a zero
+// pivot means some square cannot reach the finish. A row only reaches the
+// next six squares and any snake and ladder destinations, and elimination only
+// fills in between its first and last entries (plus the rows it is reduced
+// by), so rows are factorised in turn over just that span. Snakes make a few
+// long rows, the rest stay within a band. Returns 0 if the matrix is singular.
+static int factorise_chain(int n) {
+	for (int i = 0; i < n; i++) {
+		for (int k = row_first[i]; k < i; k++) {
+			if (chain[i][k] == 0) continue;
+
+			// Clear the columns filled in past the end of the row.
+			while (row_last[i] < row_last[k]) {
+				chain[i][++row_last[i]] = 0;
+			}
+
+			double factor = chain[i][k] /= chain[k][k];
+			for (int j = k + 1; j <= row_last[k]; j++) {
+				chain[i][j] -= factor * chain[k][j];
+			}
+		}
+		if (fabs(chain[i][i]) < 1e-12) return 0;
+	}
+	return 1;
+}
+
+// Solve (I - Q) x = b in place with the factors in chain.
+static void solve_chain(int n, double* x) {
+	for (int i = 0; i < n; i++) {
+		for (int j = row_first[i]; j < i; j++) {
+			x[i] -= chain[i][j] * x[j];
+		}
+	}
+	for (int i = n - 1; i >= 0; i--) {
+		for (int j = i + 1; j <= row_last[i]; j++) {
+			x[i] -= chain[i][j] * x[j];
+		}
+		x[i] /= chain[i][i];
+	}
+}
+
+// Solve (I - Q)^T x = b in place with the factors in chain, going down the
+// columns of each factor.
+static void solve_chain_transposed(int n, double* x) {
+	for (int i = 0; i < n; i++) {
+		x[i] /= chain[i][i];
+		for (int j = i + 1; j <= row_last[i]; j++) {
+			x[j] -= chain[i][j] * x[i];
+		}
+	}
+	for (int i = n - 1; i >= 0; i--) {
+		for (int j = row_first[i]; j < i; j++) {
+			x[j] -= chain[i][j] * x[i];
+		}
+	}
+}
+
+// Work out the statistics of a compiled level. Returns 0 if a player can get
+// stuck, i.e. the finish cannot be reached from some square the start leads to.
+static int analyse_level(const compiled_level* level, level_stats* stats) {
+	int last = BOARD_SQUARES - 1;
+	int state[BOARD_SQUARES];
+	int square[BOARD_SQUARES];
+	double t[BOARD_SQUARES];
+	double w[BOARD_SQUARES];
+	double visits[BOARD_SQUARES];
+	int n = 0;
+
+	build_jump_table(level);
+
+	// Find the squares reachable from the start and number them in path
+	// order, which keeps the forward moves next to the diagonal.
+	memset(state, 0, sizeof(state));
+	state[0] = 1;
+	for (int changed = 1; changed; ) {
+		changed = 0;
+		for (int i = 0; i < last; i++) {
+			if (!state[i]) continue;
+			for (int dice = 1; dice <= NUM_DICE_SIDES; dice++) {
+				int target = roll_destination(i, dice, level_jump);
+
+				if (!state[target]) {
+					state[target] = 1;
+					changed = 1;
+				}
+			}
+		}
+	}
+	for (int i = 0; i < last; i++) {
+		state[i] = state[i] ? n++ : -1;
+		if (state[i] >= 0) square[state[i]] = i;
+	}
+
+	// Build I - Q
+	for (int i = 0; i < n; i++) {
+		row_first[i] = row_last[i] = i;
+		for (int dice = 1; dice <= NUM_DICE_SIDES; dice++) {
+			int target = roll_destination(square[i], dice, level_jump);
+
+			if (target == last) continue;
+			if (state[target] < row_first[i]) row_first[i] = state[target];
+			if (state[target] > row_last[i]) row_last[i] = state[target];
+		}
+
+		memset(&chain[i][row_first[i]], 0, (row_last[i] - row_first[i] + 1) * sizeof(double));
+		chain[i][i] = 1;
+		for (int dice = 1; dice <= NUM_DICE_SIDES; dice++) {
+			int target = roll_destination(square[i], dice, level_jump);
+
+			if (target != last) chain[i][state[target]] -= 1.0 / NUM_DICE_SIDES;
+		}
+	}
+
+	if (!factorise_chain(n)) return 0;
+
+	for (int i = 0; i < n; i++) {
+		t[i] = 1;
+		visits[i] = (i == 0);
+	}
+	solve_chain(n, t);
+	memcpy(w, t, sizeof(double) * n);
+	solve_chain(n, w);
+	solve_chain_transposed(n, visits);
+
+	stats->expected_rolls = t[0];
+	stats->deviation = sqrt(fmax(2 * w[0] - t[0] - t[0] * t[0], 0));
+
+	// Each roll from a square lands on one of the next six with equal chance.
+	memset(stats->landings, 0, sizeof(stats->landings));
+	for (int i = 0; i < n; i++) {
+		for (int dice = 1; dice <= NUM_DICE_SIDES; dice++) {
+			int target = roll_destination(square[i], dice, NULL);
+
+			stats->landings[target] += visits[i] / NUM_DICE_SIDES;
+		}
+	}
+	return 1;
+}
+
+// Print the statistics of a level, and the landings on each square in the
+// layout of the level file if show_map is set.
+static void print_level_stats(const compiled_level* level, int show_map) {
+	static level_stats stats;
+
+	if (!analyse_level(level, &stats)) {
+		printf("%s: a player can get stuck and never finish\n", level->file_name);
+		return;
+	}
+	printf("%s: %d rolls at least, %.2f expected (standard deviation %.2f)\n",
+			level->file_name, level->min_rolls, stats.expected_rolls, stats.deviation);
+
+	if (!show_map) return;
+
+	for (int y = HEIGHT - 1; y >= 0; y--) {
+		for (int x = 0; x < WIDTH; x++) {
+			printf(" %5.2f", stats.landings[SQUARE_INDEX(x, y)]);
+		}
+		printf("\n");
+	}
+}
+
+// Write a square for the level pack as "0xNN," (two bytes, little endian, on
+// boards taller than 16 rows).
+static void print_square(FILE* out, packed_square square) {
+	fprintf(out, "0x%02X,", square & 0xFF);
+#if PACKED_SQUARE_BYTES == 2
+	fprintf(out, " 0x%02X,", square >> 8);
+#endif
+}
+
+// Write a square as raw bytes.
+static void put_square(FILE* out, packed_square square) {
+	fputc(square & 0xFF, out);
+#if PACKED_SQUARE_BYTES == 2
+	fputc(square >> 8, out);
+#endif
+}
+
+// Write the level pack header.
+static void write_level_pack(FILE* out, int num_levels) {
+	uint16_t offset = 0;
+
+	fprintf(out, "/*\n * level_pack.h\n *\n");
+	fprintf(out, " * Generated by tools/levelc.c from the files in levels/. Do not edit,\n");
+	fprintf(out, " * change the level files and run levelc again.\n */ \n\n");
+	fprintf(out, "#ifndef LEVEL_PACK_H_\n#define LEVEL_PACK_H_\n\n");
+	fprintf(out, "#include <stdint.h>\n#include <avr/pgmspace.h>\n\n");
+	fprintf(out, "#define LEVEL_PACK_COUNT %d\n", num_levels);
+	fprintf(out, "#define LEVEL_PACK_HEIGHT %d\n\n", HEIGHT);
+
+	fprintf(out, "static const uint8_t level_pack[] PROGMEM = {\n");
+	for (int i = 0; i < num_levels; i++) {
+		compiled_level* level = &levels[i];
+		const char* base_name = strrchr(level->file_name, '/');
+
+		fprintf(out, "\t// %s\n", base_name ? base_name + 1 : level->file_name);
+		for (int x = 0; x < WIDTH; x++) {
+			fprintf(out, "\t");
+			for (int y = 0; y < HEIGHT; y += 2) {
+				fprintf(out, "0x%02X,%s", (level->object[x][y] & 0xF0) | (level->object[x][y + 1] >> 4),
+						(y + 2 < HEIGHT) ? " " : "\n");
+			}
+		}
+		fprintf(out, "\t%d,\n", level->num_links);
+		for (int j = 0; j < level->num_links; j++) {
+			compiled_link* link = &level->links[j];
+
+			fprintf(out, "\t");
+			print_square(out, link->start);
+			fprintf(out, " ");
+			print_square(out, link->end);
+			fprintf(out, " ");
+			print_square(out, link->destination);
+			fprintf(out, " %d,", link->body_length);
+			for (int k = 0; k < link->body_length; k++) {
+				fprintf(out, " ");
+				print_square(out, link->body[k]);
+			}
+			fprintf(out, "\t// %s %X\n", (link->kind == KIND_SNAKE) ? "Snake" : "Ladder", link->id);
+		}
+	}
+	fprintf(out, "};\n\n");
+
+	fprintf(out, "// Offset of each level in level_pack\n");
+	fprintf(out, "static const uint16_t level_index[LEVEL_PACK_COUNT] PROGMEM = {\n");
+	for (int i = 0; i < num_levels; i++) {
+		fprintf(out, "\t%u%s\n", offset, (i + 1 < num_levels) ? "," : "");
+
+		offset += LEVEL_CELL_BYTES + 1;
+		for (int j = 0; j < levels[i].num_links; j++) {
+			offset += 3 * PACKED_SQUARE_BYTES + 1 + PACKED_SQUARE_BYTES * levels[i].links[j].body_length;
+		}
+	}
+	fprintf(out, "};\n\n");
+
+	fprintf(out, "// Fewest dice rolls needed to finish each level\n");
+	fprintf(out, "static const uint8_t level_min_rolls[LEVEL_PACK_COUNT] PROGMEM = {\n\t");
+	for (int i = 0; i < num_levels; i++) {
+		fprintf(out, "%d%s", levels[i].min_rolls, (i + 1 < num_levels) ? ", " : "\n");
+	}
+	fprintf(out, "};\n\n#endif /* LEVEL_PACK_H_ */\n");
+}
+
+// Write a level as the raw packed bytes (the same as in the level pack).
+static void write_level_image(FILE* out, compiled_level* level) {
+	for (int x = 0; x < WIDTH; x++) {
+		for (int y = 0; y < HEIGHT; y += 2) {
+			fputc((level->object[x][y] & 0xF0) | (level->object[x][y + 1] >> 4), out);
+		}
+	}
+	fputc(level->num_links, out);
+	for (int j = 0; j < level->num_links; j++) {
+		compiled_link* link = &level->links[j];
+
+		put_square(out, link->start);
+		put_square(out, link->end);
+		put_square(out, link->destination);
+		fputc(link->body_length, out);
+		for (int k = 0; k < link->body_length; k++) {
+			put_square(out, link->body[k]);
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	const char* out_name = NULL;
+	int binary = 0;
+	int analyse = 0;
+	int show_map = 0;
+	int num_levels = 0;
+
+	for (int i = 1; i < argc; i++) {
+		if ((strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "-b") == 0) && i + 1 < argc) {
+			binary = (argv[i][1] == 'b');
+			out_name = argv[++i];
+		}
+		else if (strcmp(argv[i], "-a") == 0) {
+			analyse = 1;
+		}
+		else if (strcmp(argv[i], "-v") == 0) {
+			show_map = 1;
+		}
+		else if (analyse) {
+			// Levels are rated one at a time, so there is no limit on them.
+			read_level(argv[i], &levels[0]);
+			compile_level(&levels[0]);
+			print_level_stats(&levels[0], show_map);
+			num_levels++;
+		}
+		else if (num_levels < MAX_LEVELS) {
+			read_level(argv[i], &levels[num_levels]);
+			compile_level(&levels[num_levels]);
+			num_levels++;
+		}
+		else {
+			fprintf(stderr, "levelc: at most %d levels\n", MAX_LEVELS);
+			return 1;
+		}
+	}
+
+	if (analyse && num_levels > 0) {
+		return 0;
+	}
+	if (!out_name || num_levels == 0) {
+		fprintf(stderr, "usage: levelc -o level_pack.h level_file...\n");
+		fprintf(stderr, "       levelc -b level.bin level_file\n");
+		fprintf(stderr, "       levelc -a [-v] level_file...\n");
+		return 1;
+	}
+	if (binary && num_levels != 1) {
+		fprintf(stderr, "levelc: -b takes a single level\n");
+		return 1;
+	}
+
+	FILE* out = fopen(out_name, binary ? "wb" : "w");
+	if (!out) {
+		fprintf(stderr, "levelc: cannot write %s\n", out_name);
+		return 1;
+	}
+	if (binary) {
+		write_level_image(out, &levels[0]);
+		fclose(out);
+		printf("levelc: %s written to %s\n", levels[0].file_name, out_name);
+		return 0;
+	}
+	write_level_pack(out, num_levels);
+	fclose(out);
+
+	printf("levelc: %d levels written to %s\n", num_levels, out_name);
+	return 0;
+}